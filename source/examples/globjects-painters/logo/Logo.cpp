@@ -208,7 +208,7 @@ void Logo::createAndSetupCamera()
 void Logo::createAndSetupTexture()
 {
     // Try to load texture
-    m_texture = m_resourceManager.load<globjects::Texture>(m_textureFilename.toString());
+    m_texture = m_resourceManager.get<globjects::Texture>(m_textureFilename.toString());
 
     // Check if texture is valid
     if (!m_texture) {
@@ -58,6 +58,8 @@ public:
         addOutput("color", color);
         addOutput("normal", normal);
         addOutput("geometry", geometry);
+
+        setRequiresContext(true);
     }
 
     virtual ~RasterizationStage()
@@ -188,6 +190,7 @@ public:
         addInput("geometry", geometry);
 
         alwaysProcess(true);
+        setRequiresContext(true);
     }
 
     virtual ~PostprocessingStage()
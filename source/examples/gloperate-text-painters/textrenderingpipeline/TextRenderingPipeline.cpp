@@ -41,6 +41,19 @@ TextRenderingPipeline::TextRenderingPipeline()
 , targetFBO(nullptr)
 , viewport(nullptr)
 {
+    // Redundant updates from the user interface do not trigger typesetting
+    string.setInvalidateOnlyIfChanged(true);
+    numChars.setInvalidateOnlyIfChanged(true);
+    pixelPerInch.setInvalidateOnlyIfChanged(true);
+    fontSize.setInvalidateOnlyIfChanged(true);
+    origin.setInvalidateOnlyIfChanged(true);
+    margins.setInvalidateOnlyIfChanged(true);
+    wordWrap.setInvalidateOnlyIfChanged(true);
+    lineWidth.setInvalidateOnlyIfChanged(true);
+    alignment.setInvalidateOnlyIfChanged(true);
+    lineAnchor.setInvalidateOnlyIfChanged(true);
+    optimized.setInvalidateOnlyIfChanged(true);
+
     auto fontImport = new gloperate_text::FontImporterStage;
     auto demo = new GlyphSequenceDemoStage;
     auto glyphPreparation = new gloperate_text::GlyphPreparationStage;
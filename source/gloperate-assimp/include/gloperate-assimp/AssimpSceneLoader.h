@@ -47,6 +47,7 @@ public:
     virtual bool canLoad(const std::string & ext) const override;
     virtual std::vector<std::string> loadingTypes() const override;
     virtual std::string allLoadingTypes() const override;
+    virtual bool requiresContext() const override;
     virtual gloperate::Scene * load(const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> progress) const override;
 
 
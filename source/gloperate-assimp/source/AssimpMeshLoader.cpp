@@ -103,7 +103,13 @@ std::string AssimpMeshLoader::allLoadingTypes() const
     return string;
 }
 
-PolygonalGeometry * AssimpMeshLoader::load(const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> /*progress*/) const
+bool AssimpMeshLoader::requiresContext() const
+{
+    // Only CPU-side geometry is created, so loading can run on any thread
+    return false;
+}
+
+PolygonalGeometry * AssimpMeshLoader::load(const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> progress) const
 {
     bool smoothNormals = false;
 
@@ -114,6 +120,8 @@ PolygonalGeometry * AssimpMeshLoader::load(const std::string & filename, const r
     }
 
     // Import scene
+    if (progress) progress(0, 2);
+
     auto scene = aiImportFile(
         filename.c_str(),
         aiProcess_Triangulate           |
@@ -128,12 +136,16 @@ PolygonalGeometry * AssimpMeshLoader::load(const std::string & filename, const r
         return nullptr;
     }
 
+    if (progress) progress(1, 2);
+
     // Convert first mesh found in the scene
     PolygonalGeometry * geometry = nullptr;
     if (scene->mNumMeshes > 0) {
         geometry = convertGeometry(scene->mMeshes[0]);
     }
 
+    if (progress) progress(2, 2);
+
     // Release scene
     aiReleaseImport(scene);
 
@@ -104,7 +104,13 @@ std::string AssimpSceneLoader::allLoadingTypes() const
     return string;
 }
 
-Scene * AssimpSceneLoader::load(const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> /*progress*/) const
+bool AssimpSceneLoader::requiresContext() const
+{
+    // Only CPU-side geometry is created, so loading can run on any thread
+    return false;
+}
+
+Scene * AssimpSceneLoader::load(const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> progress) const
 {
     bool smoothNormals = false;
 
@@ -115,6 +121,8 @@ Scene * AssimpSceneLoader::load(const std::string & filename, const reflectionze
     }
 
     // Import scene
+    if (progress) progress(0, 2);
+
     auto assimpScene = aiImportFile(
         filename.c_str(),
         aiProcess_Triangulate           |
@@ -129,9 +137,13 @@ Scene * AssimpSceneLoader::load(const std::string & filename, const reflectionze
         return nullptr;
     }
 
+    if (progress) progress(1, 2);
+
     // Convert scene into gloperate scene
     Scene * scene = convertScene(assimpScene);
 
+    if (progress) progress(2, 2);
+
     // Release scene
     aiReleaseImport(assimpScene);
 
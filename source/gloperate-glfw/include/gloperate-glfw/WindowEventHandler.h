@@ -16,6 +16,7 @@ public:
     virtual ~WindowEventHandler();
 
     virtual void initialize(gloperate_glfw::Window & window) override;
+    virtual void idle(gloperate_glfw::Window & window) override;
 
 
 protected:
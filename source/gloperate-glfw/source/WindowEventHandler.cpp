@@ -1,6 +1,8 @@
 
 #include <gloperate-glfw/WindowEventHandler.h>
 
+#include <chrono>
+
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
@@ -9,6 +11,7 @@
 #include <gloperate/painter/AbstractViewportCapability.h>
 #include <gloperate/painter/AbstractVirtualTimeCapability.h>
 #include <gloperate/painter/AbstractInputCapability.h>
+#include <gloperate/resources/ResourceManager.h>
 #include <gloperate/tools/ImageExporter.h>
 
 #include <gloperate-glfw/Window.h>
@@ -72,6 +75,13 @@ void WindowEventHandler::initialize(Window & window)
         window.painter()->initialize();
     }
 
+void WindowEventHandler::idle(Window & window)
+{
+    // Keep painting until asynchronous requests are done, as they may need the context to finish
+    if (window.resourceManager().hasPendingRequests())
+        window.repaint();
+}
+
 void WindowEventHandler::framebufferResizeEvent(ResizeEvent & event)
 {
     if (event.window()->painter()) {
@@ -88,6 +98,9 @@ void WindowEventHandler::framebufferResizeEvent(ResizeEvent & event)
 
 void WindowEventHandler::paintEvent(PaintEvent & event)
 {
+    // Create resources that have been loaded asynchronously, without stalling the frame for too long
+    event.window()->resourceManager().processUploads(std::chrono::milliseconds(5));
+
     if (event.window()->painter()) {
         // Call painter
         event.window()->painter()->paint();
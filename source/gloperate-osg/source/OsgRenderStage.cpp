@@ -34,6 +34,8 @@ OsgRenderStage::OsgRenderStage(const std::string & name)
     // Register output slots
     addOutput("projectionMatrix", m_projectionMatrix);
     addOutput("viewMatrix",       m_viewMatrix);
+
+    setRequiresContext(true);
 }
 
 OsgRenderStage::~OsgRenderStage()
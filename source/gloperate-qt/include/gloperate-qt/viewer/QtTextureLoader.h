@@ -26,6 +26,9 @@ namespace gloperate_qt
 *
 *  Supported options:
 *    none
+*
+*  Images are decoded by prepare(), so that asynchronous
+*  loading only uploads the texture on the context thread.
 */
 class GLOPERATE_QT_API QtTextureLoader : public gloperate::Loader<globjects::Texture> 
 {
@@ -46,13 +49,16 @@ public:
     virtual bool canLoad(const std::string & ext) const;
     virtual std::vector<std::string> loadingTypes() const;
     virtual std::string allLoadingTypes() const;
+    virtual bool canLoadContent(const char * header, size_t size) const;
 
     // Virtual gloperate::Loader<globjects::Texture> functions
     virtual globjects::Texture * load(const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> progress) const override;
+    virtual std::unique_ptr<Prepared> prepare(const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> progress) const override;
+    virtual globjects::Texture * finish(const std::string & filename, const reflectionzeug::Variant & options, std::unique_ptr<Prepared> prepared, std::function<void(int, int)> progress) const override;
 
 
 protected:
-    std::vector<std::string> m_extensions; /**< List of supported file extensions (e.g., ".bmp") */
+    std::vector<std::string> m_extensions; /**< List of supported file extensions (e.g., "bmp") */
     std::vector<std::string> m_types;      /**< List of supported file types (e.g., "bmp image (*.bmp)") */
 };
 
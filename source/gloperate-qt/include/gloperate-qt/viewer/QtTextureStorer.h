@@ -49,7 +49,7 @@ public:
 
 
 protected:
-    std::vector<std::string> m_extensions; /**< List of supported file extensions (e.g., ".bmp") */
+    std::vector<std::string> m_extensions; /**< List of supported file extensions (e.g., "bmp") */
     std::vector<std::string> m_types;      /**< List of supported file types (e.g., "bmp image (*.bmp)") */
 };
 
@@ -1,6 +1,8 @@
 
 #include "gloperate-qt/viewer/QtOpenGLWindow.h"
 
+#include <chrono>
+
 #include <gloperate/ext-includes-begin.h>
 #include <QResizeEvent>
 #include <QKeyEvent>
@@ -124,6 +126,13 @@ void QtOpenGLWindow::onResize(QResizeEvent * event)
 
 void QtOpenGLWindow::onPaint()
 {
+    // Create resources that have been loaded asynchronously, without stalling the frame for too long
+    m_resourceManager.processUploads(std::chrono::milliseconds(5));
+
+    if (m_resourceManager.hasPendingRequests()) {
+        updateGL();
+    }
+
     // Update script timers
     if (m_timerApi && m_painter) {
         AbstractVirtualTimeCapability * virtualTimeCapability = m_painter->getCapability<AbstractVirtualTimeCapability>();
@@ -3,6 +3,8 @@
 
 #include <gloperate/ext-includes-begin.h>
 #include <QString>
+#include <QBuffer>
+#include <QByteArray>
 #include <QImage>
 #include <QImageReader>
 #include <gloperate/ext-includes-end.h>
@@ -16,6 +18,20 @@
 #include <gloperate-qt/viewer/Converter.h>
 
 
+namespace
+{
+
+
+class PreparedImage : public gloperate::AbstractLoader::Prepared
+{
+public:
+    QImage image;   /**< Image in RGBA format */
+};
+
+
+} // namespace
+
+
 namespace gloperate_qt
 {
 
@@ -27,7 +43,7 @@ QtTextureLoader::QtTextureLoader()
     QList<QByteArray> formats = QImageReader::supportedImageFormats();
     for (int i = 0; i < formats.size(); ++i) {
         std::string format = std::string(formats[i].data());
-        m_extensions.push_back(std::string(".") + format);
+        m_extensions.push_back(format);
         m_types.push_back(format + " image (*." + format + ")");
     }
 
@@ -35,7 +51,7 @@ QtTextureLoader::QtTextureLoader()
     std::string allTypes;
     for (unsigned int i = 0; i < m_extensions.size(); ++i) {
         if (i > 0) allTypes += " ";
-        allTypes += "*." + m_extensions[i].substr(1);
+        allTypes += "*." + m_extensions[i];
     }
     m_types.push_back(std::string("Qt image formats (") + allTypes + ")");
 }
@@ -47,7 +63,17 @@ QtTextureLoader::~QtTextureLoader()
 bool QtTextureLoader::canLoad(const std::string & ext) const
 {
     // Check if file type is supported
-    return (std::count(m_extensions.begin(), m_extensions.end(), "." + ext) > 0);
+    return (std::find(m_extensions.begin(), m_extensions.end(), ext) != m_extensions.end());
+}
+
+bool QtTextureLoader::canLoadContent(const char * header, size_t size) const
+{
+    // Let Qt detect the image format from the header
+    QByteArray data = QByteArray::fromRawData(header, static_cast<int>(size));
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+
+    return !QImageReader::imageFormat(&buffer).isEmpty();
 }
 
 std::vector<std::string> QtTextureLoader::loadingTypes() const
@@ -62,38 +88,57 @@ std::string QtTextureLoader::allLoadingTypes() const
     std::string allTypes;
     for (unsigned int i = 0; i < m_extensions.size(); ++i) {
         if (i > 0) allTypes += " ";
-        allTypes += "*." + m_extensions[i].substr(1);
+        allTypes += "*." + m_extensions[i];
     }
 
     // Return supported types
     return allTypes;
 }
 
-globjects::Texture * QtTextureLoader::load(const std::string & filename, const reflectionzeug::Variant & /*options*/, std::function<void(int, int)> /*progress*/) const
+globjects::Texture * QtTextureLoader::load(const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> progress) const
+{
+    return finish(filename, options, prepare(filename, options, progress), progress);
+}
+
+std::unique_ptr<gloperate::AbstractLoader::Prepared> QtTextureLoader::prepare(const std::string & filename, const reflectionzeug::Variant & /*options*/, std::function<void(int, int)> /*progress*/) const
 {
     // Load image
     QImage image;
-    if (image.load(QString::fromStdString(filename))) {
-        // Convert image into RGBA format
-        QImage converted = Converter::convert(image);
-
-        // Create texture
-        globjects::Texture * texture = globjects::Texture::createDefault(gl::GL_TEXTURE_2D);
-        texture->image2D(
-            0,
-            gl::GL_RGBA8,
-            converted.width(),
-            converted.height(),
-            0,
-            gl::GL_RGBA,
-            gl::GL_UNSIGNED_BYTE,
-            converted.constBits()
-        );
-        return texture;
+    if (!image.load(QString::fromStdString(filename))) {
+        // Could not load image
+        return nullptr;
+    }
+
+    // Convert image into RGBA format
+    auto preparedImage = new PreparedImage;
+    std::unique_ptr<Prepared> prepared(preparedImage);
+    preparedImage->image = Converter::convert(image);
+
+    return prepared;
+}
+
+globjects::Texture * QtTextureLoader::finish(const std::string & /*filename*/, const reflectionzeug::Variant & /*options*/, std::unique_ptr<Prepared> prepared, std::function<void(int, int)> /*progress*/) const
+{
+    const PreparedImage * preparedImage = static_cast<const PreparedImage *>(prepared.get());
+    if (!preparedImage) {
+        return nullptr;
     }
 
-    // Could not load image
-    return nullptr;
+    const QImage & image = preparedImage->image;
+
+    // Create texture
+    globjects::Texture * texture = globjects::Texture::createDefault(gl::GL_TEXTURE_2D);
+    texture->image2D(
+        0,
+        gl::GL_RGBA8,
+        image.width(),
+        image.height(),
+        0,
+        gl::GL_RGBA,
+        gl::GL_UNSIGNED_BYTE,
+        image.constBits()
+    );
+    return texture;
 }
 
 
@@ -23,7 +23,7 @@ QtTextureStorer::QtTextureStorer()
     QList<QByteArray> formats = QImageWriter::supportedImageFormats();
     for (int i = 0; i < formats.size(); ++i) {
         std::string format = std::string(formats[i].data());
-        m_extensions.push_back(std::string(".") + format);
+        m_extensions.push_back(format);
         m_types.push_back(format + " image (*." + format + ")");
     }
 
@@ -31,7 +31,7 @@ QtTextureStorer::QtTextureStorer()
     std::string allTypes;
     for (unsigned int i = 0; i < m_extensions.size(); ++i) {
         if (i > 0) allTypes += " ";
-        allTypes += "*." + m_extensions[i].substr(1);
+        allTypes += "*." + m_extensions[i];
     }
     m_types.push_back(std::string("Qt image formats (") + allTypes + ")");
 }
@@ -43,7 +43,7 @@ QtTextureStorer::~QtTextureStorer()
 bool QtTextureStorer::canStore(const std::string & ext) const
 {
      // Check if file type is supported
-    return (std::count(m_extensions.begin(), m_extensions.end(), "." + ext) > 0);
+    return (std::find(m_extensions.begin(), m_extensions.end(), ext) != m_extensions.end());
 }
 
 std::vector<std::string> QtTextureStorer::storingTypes() const
@@ -58,7 +58,7 @@ std::string QtTextureStorer::allStoringTypes() const
     std::string allTypes;
     for (unsigned int i = 0; i < m_extensions.size(); ++i) {
         if (i > 0) allTypes += " ";
-        allTypes += "*." + m_extensions[i].substr(1);
+        allTypes += "*." + m_extensions[i];
     }
 
     // Return supported types
@@ -26,6 +26,7 @@
 #include <gloperate/ext-includes-end.h>
 
 #include <gloperate/resources/ResourceManager.h>
+#include <gloperate/resources/GlrawTextureLoader.h>
 #include <gloperate/plugin/PluginManager.h>
 #include <gloperate/plugin/PainterPlugin.h>
 #include <gloperate/tools/ImageExporter.h>
@@ -114,6 +115,7 @@ Viewer::Viewer(QWidget * parent, Qt::WindowFlags flags)
 
     // Add default texture loaders/storers
     m_resourceManager->addLoader(new QtTextureLoader());
+    m_resourceManager->addLoader(new GlrawTextureLoader());
     m_resourceManager->addStorer(new QtTextureStorer());
 
     // Add assimp loaders (if available)
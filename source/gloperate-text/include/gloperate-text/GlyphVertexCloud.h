@@ -9,6 +9,7 @@
 #include <globjects/base/ref_ptr.h>
 #include <globjects/Texture.h>
 
+#include <gloperate/pipeline/DataSize.h>
 #include <gloperate/primitives/Drawable.h>
 
 #include <gloperate-text/gloperate-text_api.h>
@@ -69,3 +70,23 @@ protected:
 
 
 } // namespace gloperate_text
+
+
+namespace gloperate
+{
+
+
+/**
+*  @brief
+*    Memory held by the vertices and the vertex buffer of a vertex cloud
+*
+*    The glyph texture belongs to the font face and is not counted.
+*/
+template <>
+struct GLOPERATE_TEXT_API DataSize<gloperate_text::GlyphVertexCloud>
+{
+    static size_t sizeInBytes(const gloperate_text::GlyphVertexCloud & vertexCloud);
+};
+
+
+} // namespace gloperate
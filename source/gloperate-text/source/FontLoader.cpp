@@ -34,7 +34,7 @@ FontLoader::FontLoader(gloperate::ResourceManager & resourceManager)
 
 bool FontLoader::canLoad(const std::string & ext) const
 {
-    return ext == ".txt";
+    return ext == "txt";
 }
 
 std::vector<std::string> FontLoader::loadingTypes() const
@@ -160,6 +160,7 @@ void FontLoader::handlePage(std::stringstream & stream, FontFace & fontFace, con
         fontFace.setGlyphTexture(texture);
     }
     else
+        // Not shared through the cache, since the sampling state below is changed
         fontFace.setGlyphTexture(m_resourceManager.load<globjects::Texture>(path + "/" + file));
 
     fontFace.glyphTexture()->setParameter(gl::GL_TEXTURE_MIN_FILTER, gl::GL_LINEAR);
@@ -157,3 +157,23 @@ void GlyphVertexCloud::optimize(
 
 
 } // namespace gloperate_text
+
+
+namespace gloperate
+{
+
+
+size_t DataSize<gloperate_text::GlyphVertexCloud>::sizeInBytes(const gloperate_text::GlyphVertexCloud & vertexCloud)
+{
+    using Vertices = gloperate_text::GlyphVertexCloud::Vertices;
+
+    size_t size = sizeof(vertexCloud) - sizeof(Vertices) + DataSize<Vertices>::sizeInBytes(vertexCloud.vertices());
+
+    if (vertexCloud.drawable())
+        size += DataSize<globjects::Buffer *>::sizeInBytes(vertexCloud.drawable()->buffer(0));
+
+    return size;
+}
+
+
+} // namespace gloperate
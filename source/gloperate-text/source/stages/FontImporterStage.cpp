@@ -18,6 +18,8 @@ FontImporterStage::FontImporterStage()
     addInput("fontFilePath", fontFilePath);
 
     addOutput("font", font);
+
+    setRequiresContext(true);
 }
 
 FontImporterStage::~FontImporterStage()
@@ -20,6 +20,8 @@ GlyphPreparationStage::GlyphPreparationStage()
     addInput("optimized", optimized);
 
     addOutput("vertexCloud", vertexCloud);
+
+    setRequiresContext(true);
 }
 
 GlyphPreparationStage::~GlyphPreparationStage()
@@ -26,6 +26,7 @@ GlyphRenderStage::GlyphRenderStage()
     addInput("targetFramebuffer", targetFramebuffer);
 
     alwaysProcess(true);
+    setRequiresContext(true);
 }
 
 GlyphRenderStage::~GlyphRenderStage()
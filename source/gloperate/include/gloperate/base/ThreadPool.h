@@ -0,0 +1,113 @@
+#pragma once
+
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+
+/**
+*  @brief
+*    Work-stealing thread pool
+*
+*    Each worker owns a task queue. Tasks submitted from a worker
+*    are pushed to that worker's queue, all other tasks are
+*    distributed round-robin. Idle workers steal from the queues
+*    of the other workers, so unbalanced task sets keep all
+*    threads busy.
+*
+*    Threads waiting for a result can help out by executing
+*    pending tasks instead of blocking:
+*
+*    \code{.cpp}
+*
+*        ThreadPool pool;
+*        auto result = pool.submit([]() { return expensiveComputation(); });
+*        pool.wait(result); // executes other pending tasks meanwhile
+*
+*    \endcode
+*/
+class GLOPERATE_API ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] numThreads
+    *    Number of worker threads (0 uses the number of hardware threads)
+    */
+    explicit ThreadPool(unsigned int numThreads = 0);
+
+    /**
+    *  @brief
+    *    Destructor
+    *
+    *    Executes all pending tasks and joins the worker threads.
+    */
+    virtual ~ThreadPool();
+
+    // Fixes issues with MSVC2013 Update 3
+    ThreadPool(const ThreadPool & rhs) = delete;
+    ThreadPool & operator=(const ThreadPool & rhs) = delete;
+
+    unsigned int size() const;
+
+    void execute(Task task);
+
+    template <typename Callable>
+    auto submit(Callable callable) -> std::future<decltype(callable())>;
+
+    bool runPendingTask();
+
+    template <typename T>
+    void wait(const std::future<T> & future);
+
+
+protected:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+
+protected:
+    void run(unsigned int index);
+    bool popTask(unsigned int index, Task & task);
+    bool stealTask(unsigned int index, Task & task);
+
+
+protected:
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_threads;
+
+    std::atomic<unsigned int> m_nextWorker;
+    std::atomic<unsigned int> m_numPending;
+    std::atomic<bool> m_running;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeUp;
+};
+
+
+} // namespace gloperate
+
+
+#include <gloperate/base/ThreadPool.hpp>
@@ -0,0 +1,39 @@
+#pragma once
+
+
+#include <chrono>
+
+#include <gloperate/base/ThreadPool.h>
+
+
+namespace gloperate
+{
+
+
+template <typename Callable>
+auto ThreadPool::submit(Callable callable) -> std::future<decltype(callable())>
+{
+    using Result = decltype(callable());
+
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::move(callable));
+    std::future<Result> future = task->get_future();
+
+    execute([task]() { (*task)(); });
+
+    return future;
+}
+
+template <typename T>
+void ThreadPool::wait(const std::future<T> & future)
+{
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        if (!runPendingTask())
+        {
+            future.wait_for(std::chrono::microseconds(100));
+        }
+    }
+}
+
+
+} // namespace gloperate
@@ -39,6 +39,8 @@ public:
     virtual ~AbstractOutputCapability();
 
     virtual std::vector<gloperate::AbstractData*> findOutputs(const std::string & name) const;
+    virtual gloperate::AbstractData * findOutput(const std::string & name, size_t typeId) const;
+    virtual gloperate::AbstractData * findOutputOfType(size_t typeId) const;
 
     template <typename T>
     Data<T> * getOutput(const std::string & name) const;
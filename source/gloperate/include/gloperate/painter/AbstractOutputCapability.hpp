@@ -2,7 +2,6 @@
 #pragma once
 
 
-#include <gloperate/base/collection.hpp>
 #include <gloperate/pipeline/Data.h>
 
 
@@ -13,22 +12,13 @@ namespace gloperate
 template <typename T>
 gloperate::Data<T> * AbstractOutputCapability::getOutput(const std::string & name) const
 {
-    for (AbstractData* output : findOutputs(name))
-    {
-        auto data = dynamic_cast<Data<T>*>(output);
-        if (data)
-        {
-            return data;
-        }
-    }
-
-    return nullptr;
+    return static_cast<Data<T>*>(findOutput(name, TypeToken<T>::id()));
 }
 
 template <typename T>
 gloperate::Data<T> * AbstractOutputCapability::getOutput() const
 {
-    return dynamic_cast<Data<T>*>(collection::detect(allOutputs(), [](AbstractData * data) { return dynamic_cast<Data<T>*>(data) != nullptr; }, nullptr));
+    return static_cast<Data<T>*>(findOutputOfType(TypeToken<T>::id()));
 }
 
 
@@ -39,6 +39,10 @@ public:
 
     virtual std::vector<gloperate::AbstractData*> allOutputs() const override;
 
+    virtual std::vector<gloperate::AbstractData*> findOutputs(const std::string & name) const override;
+    virtual gloperate::AbstractData * findOutput(const std::string & name, size_t typeId) const override;
+    virtual gloperate::AbstractData * findOutputOfType(size_t typeId) const override;
+
 
 protected:
     const gloperate::AbstractPipeline & m_pipeline;
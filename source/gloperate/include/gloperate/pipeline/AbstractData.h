@@ -2,7 +2,9 @@
 #pragma once
 
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <signalzeug/Signal.h>
 
@@ -14,18 +16,38 @@ namespace gloperate
 
 
 class AbstractStage;
+class AbstractInputSlot;
+class AbstractPipeline;
 
 
 /**
 *  @brief
 *    Base class for typed data containers
 *
+*    A data container knows the input slots it is connected to.
+*    Invalidating the data directly marks the stages owning
+*    these slots as dirty, so the pipeline only has to visit
+*    stages whose inputs have actually changed.
+*
+*    Data containers can optionally provide a hash of their content
+*    and copies of their value, which are used to memoize the
+*    results of stages.
+*
+*    The memory held by a value is reported by sizeInBytes(),
+*    which is used for the memory report of the pipeline.
+*
+*    While an update of the pipeline is open, invalidating stage
+*    outputs or pipeline parameters is deferred until the update
+*    ends. Each data container is then invalidated only once.
+*
 *  @see
 *    Data
 */
 class GLOPERATE_API AbstractData
 {
     friend class AbstractStage;
+    friend class AbstractInputSlot;
+    friend class AbstractPipeline;
 
 
 public:
@@ -52,16 +74,82 @@ public:
 
     bool matchesName(const std::string & name) const;
 
+    /**
+    *  @brief
+    *    Get readable name of the type of the value
+    *
+    *  @return
+    *    Type name (for diagnostics)
+    */
     virtual std::string type() const = 0;
 
+    /**
+    *  @brief
+    *    Get id of the type of the value
+    *
+    *  @return
+    *    Type id (0 if untyped)
+    *
+    *  @see TypeToken
+    */
+    size_t typeId() const;
+
+    virtual bool contentHash(size_t & hash) const;
+
+    /**
+    *  @brief
+    *    Check if copies of the value can be taken
+    *
+    *  @return
+    *    'true' if snapshot() and restore() are supported, else 'false'
+    */
+    virtual bool canSnapshot() const;
+    virtual std::shared_ptr<AbstractData> snapshot() const;
+    virtual bool restore(const AbstractData & snapshot);
+
+    virtual bool hasHistory() const;
+
+    /**
+    *  @brief
+    *    Get number of previous values that are kept
+    *
+    *  @return
+    *    Length of the history (0 if there is none)
+    *
+    *  @see HistoryData
+    */
+    virtual size_t historyLength() const;
+    virtual void advanceHistory();
+
+    /**
+    *  @brief
+    *    Get memory held by the value
+    *
+    *  @return
+    *    Size of the value and the memory it owns (in bytes)
+    *
+    *  @see DataSize
+    */
+    virtual size_t sizeInBytes() const;
+
 
 protected:
     void setOwner(AbstractStage * owner);
 
+    void addConsumer(AbstractInputSlot * slot) const;
+    void removeConsumer(AbstractInputSlot * slot) const;
+
+    void propagateInvalidation();
+
 
 protected:
     AbstractStage * m_owner;
     std::string m_name;
+    size_t m_typeId;                /**< Id of the type of the value, set by Data */
+    AbstractPipeline * m_pipeline;  /**< Pipeline this data is a parameter of (nullptr if none) */
+    bool m_invalidationPending;     /**< Invalidation is deferred by an update of the pipeline */
+
+    mutable std::vector<AbstractInputSlot *> m_consumers; /**< Input slots connected to this data */
 };
 
 
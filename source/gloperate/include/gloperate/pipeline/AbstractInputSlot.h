@@ -3,6 +3,7 @@
 
 
 #include <string>
+#include <vector>
 
 #include <signalzeug/Signal.h>
 
@@ -27,6 +28,8 @@ class AbstractStage;
 class GLOPERATE_API AbstractInputSlot
 {
     friend class AbstractStage;
+    friend class AbstractData;
+    friend class AbstractPipeline;
 
 
 public:
@@ -49,6 +52,17 @@ public:
 
     virtual std::string qualifiedName() const;
 
+    /**
+    *  @brief
+    *    Get id of the type of the slot
+    *
+    *  @return
+    *    Type id (0 if untyped)
+    *
+    *  @see TypeToken
+    */
+    size_t typeId() const;
+
     virtual bool connectTo(const AbstractData & data) = 0;
     virtual bool matchType(const AbstractData & data) = 0;
 
@@ -73,10 +87,17 @@ public:
 protected:
     void setOwner(AbstractStage * owner);
 
+    void registerAt(const AbstractData & data);
+    void unregisterAt(const AbstractData & data);
+
+    virtual void dataDestroyed() = 0;
+
 
 protected:
     AbstractStage * m_owner;
+    std::vector<AbstractStage *> m_sharingStages; /**< Stages that share this input slot */
     std::string m_name;
+    size_t m_typeId;    /**< Id of the type of the slot, set by InputSlot */
 
     bool m_hasChanged;
     bool m_isOptional;
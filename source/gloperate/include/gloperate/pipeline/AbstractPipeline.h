@@ -1,11 +1,17 @@
 
 #pragma once
 
+#include <iosfwd>
 #include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
+#include <gloperate/base/ChronoTimer.h>
+
+#include <gloperate/pipeline/DataIndex.h>
+#include <gloperate/pipeline/MemoryReport.h>
+
 #include <gloperate/gloperate_api.h>
 
 
@@ -16,6 +22,11 @@ namespace gloperate
 class AbstractData;
 class AbstractStage;
 class AbstractInputSlot;
+class AsyncStage;
+class ExecutionPlan;
+class MemoryTracker;
+class ThreadPool;
+class StageProfiler;
 
 template <typename T>
 class Data;
@@ -36,12 +47,90 @@ class Data;
 *    determined which stage has to be executed and in what order
 *    the stages are processed.
 *
+*    Stages are notified by their inputs when data changes and
+*    report themselves as dirty to the pipeline. An execution
+*    only visits the dirty stages in topological order, so an
+*    execution without any changes is almost free.
+*
+*    Instead of executing the whole pipeline, evaluate() only
+*    processes the stages that contribute to the requested
+*    outputs. All other dirty stages keep their state until
+*    they are needed.
+*
+*    By default, all stages are executed sequentially on the
+*    calling thread. With parallel execution enabled, stages are
+*    grouped into dependency levels and the stages of one level
+*    are dispatched to a work-stealing thread pool. Stages that
+*    require the OpenGL context are always executed on the calling
+*    thread. As a level is only started after its predecessor has
+*    finished, results are the same as for sequential execution.
+*
+*    Asynchronous stages process on their own worker threads. Their
+*    results are published at the beginning of the next execute()
+*    or evaluate() call after they have finished, so the pipeline
+*    never waits for them.
+*
+*    Parameters and outputs are indexed by name, qualified name,
+*    and type, so finding them takes constant time. The index is
+*    updated when stages or parameters are added or renamed.
+*
+*    With profiling enabled, each execution of a stage is timed
+*    and every execute() or evaluate() call is recorded as a frame.
+*    The recorded frames can be written as Chrome trace event JSON
+*    and the accumulated statistics as a summary table. Disabled
+*    profiling costs a single pointer check per stage execution.
+*
+*    The memory held by parameters, stage outputs, and memoized
+*    outputs is listed by memoryReport(). With memory tracking
+*    enabled, the outputs are measured after each execution of a
+*    stage to record their peak sizes.
+*
+*    Changes to several parameters can be grouped into an update
+*    (see beginUpdate() or PipelineTransaction). Invalidations and
+*    changed connections within an update are collected and
+*    delivered once when the update ends, so each stage is only
+*    notified and scheduled once.
+*
+*    With a frame budget, execute() first processes all stages that
+*    are not deferrable. Dirty deferrable stages are then processed
+*    by priority until the budget is used up; the remaining ones
+*    are carried over to the next execution. Deferrable stages that
+*    become dirty meanwhile follow after the ones dirty before.
+*
+*    A compiled pipeline executes through a frozen execution plan
+*    (see compile()), which skips the per-stage usability checks and
+*    replaces the scheduling heap by a bitmask. Adding stages or
+*    changing connections discards the plan; it is rebuilt on the
+*    next execution.
+*
 *  @see AbstractStage
 *  @see Data
 *  @see InputSlot
+*  @see PipelineTransaction
 */
 class GLOPERATE_API AbstractPipeline
 {
+    friend class AbstractData;
+    friend class AbstractStage;
+
+
+public:
+    /**
+    *  @brief
+    *    Time spent in the last execution with a frame budget
+    */
+    struct BudgetUsage
+    {
+        BudgetUsage();
+
+        ChronoTimer::Duration budget;
+        ChronoTimer::Duration critical;     /**< Time spent on stages that cannot be deferred */
+        ChronoTimer::Duration deferred;     /**< Time spent on deferrable stages */
+        size_t processedDeferred;           /**< Number of deferrable stages processed */
+        size_t carriedOver;                 /**< Number of deferrable stages left dirty */
+    };
+
+
 public:
     AbstractPipeline(const std::string & name = "");
     virtual ~AbstractPipeline();
@@ -64,6 +153,84 @@ public:
 
     virtual void execute();
 
+    void evaluate(AbstractData * output);
+    void evaluate(const std::vector<AbstractData *> & outputs);
+
+    /**
+    *  @brief
+    *    Execute the pipeline through a frozen execution plan
+    *
+    *    The plan is discarded whenever stages or connections change
+    *    and rebuilt on the next execution, until discardPlan() is
+    *    called. Parallel execution does not use the plan.
+    *
+    *  @return
+    *    'true' if the plan could be built, 'false' if the pipeline is not sortable
+    */
+    bool compile();
+    bool isCompiled() const;
+    void discardPlan();
+
+    /**
+    *  @brief
+    *    Set the time per execution available for deferrable stages
+    *
+    *  @param[in] budget
+    *    Budget, zero to process all stages in every execution
+    *
+    *  @remarks
+    *    The budget is ignored by parallel execution and evaluate().
+    */
+    void setFrameBudget(ChronoTimer::Duration budget);
+    ChronoTimer::Duration frameBudget() const;
+    const BudgetUsage & budgetUsage() const;
+
+    void setParallelExecution(bool enabled, unsigned int numThreads = 0);
+    bool parallelExecution() const;
+
+    void setProfiling(bool enabled, size_t historySize = 120);
+    bool profiling() const;
+    StageProfiler * profiler() const;
+
+    void writeTrace(std::ostream & stream) const;
+    void writeProfileSummary(std::ostream & stream) const;
+
+    void setMemoryTracking(bool enabled);
+    bool memoryTracking() const;
+    MemoryTracker * memoryTracker() const;
+
+    /**
+    *  @brief
+    *    Measure the memory held by the pipeline
+    *
+    *  @return
+    *    Sizes per parameter, per stage, and per output
+    *
+    *  @remarks
+    *    Sizes of textures and buffers are queried from OpenGL,
+    *    so the context has to be current.
+    */
+    MemoryReport memoryReport() const;
+    void writeMemoryReport(std::ostream & stream) const;
+
+    /**
+    *  @brief
+    *    Start deferring invalidations of parameters and stage outputs
+    *
+    *    Updates can be nested, pending invalidations are delivered
+    *    when the outermost update ends or the pipeline is executed.
+    *    Data must not be destroyed while its invalidation is pending.
+    */
+    void beginUpdate();
+
+    /**
+    *  @brief
+    *    End an update and deliver its invalidations once each
+    */
+    void endUpdate();
+
+    bool isUpdating() const;
+
     virtual void addStage(AbstractStage * stage);
 
     void addParameter(AbstractData * parameter);
@@ -80,6 +247,8 @@ public:
 
     AbstractData * findParameter(const std::string & name) const;
     std::vector<AbstractData *> findOutputs(const std::string & name) const;
+    AbstractData * findOutput(const std::string & name, size_t typeId) const;
+    AbstractData * findOutputOfType(size_t typeId) const;
 
     template <typename T>
     Data<T> * getParameter(const std::string & name) const;
@@ -105,7 +274,34 @@ protected:
     void addStages();
     bool initializeStages();
 
-    static bool tsort(std::vector<AbstractStage *> &stages);
+    void publishAsyncResults();
+    void executeSequential();
+    void executeWithinBudget();
+    void executeRequired(const std::vector<bool> & requiredStages);
+    bool executeStage(size_t index);
+    void executeParallel();
+    void processScheduledStages(const std::vector<bool> * requiredStages);
+    void executePlan(const std::vector<bool> * requiredStages);
+    bool buildPlan();
+    void invalidatePlan();
+    std::vector<bool> requiredStages(const std::vector<AbstractData *> & outputs) const;
+    void computeStageLevels();
+
+    void scheduleStage(AbstractStage * stage);
+    void rebuildSchedule();
+
+    bool deferInvalidation(AbstractData * data);
+    void deliverInvalidations();
+
+    void stageDependenciesChanged(AbstractStage * stage);
+    void updateDependencies(AbstractStage * stage);
+    std::vector<AbstractStage *> updatePredecessors(AbstractStage * stage);
+    bool insertEdge(AbstractStage * from, AbstractStage * to);
+
+    static bool tsort(std::vector<AbstractStage *> & stages);
+
+    void invalidateDataIndex();
+    void updateDataIndex() const;
 
 
 protected:
@@ -116,6 +312,34 @@ protected:
     std::vector<AbstractData *> m_parameters;
     std::vector<const AbstractData *> m_sharedData;
     bool m_dependenciesSorted;
+
+    mutable DataIndex m_parameterIndex;
+    mutable DataIndex m_outputIndex;
+    mutable bool m_dataIndexValid;  /**< Indices are rebuilt on the next lookup if invalid */
+
+    std::vector<size_t> m_scheduledStages;  /**< Min-heap of the indices of dirty stages */
+    std::vector<size_t> m_deferredStages;   /**< Indices of stages that stay dirty until the next execution */
+    size_t m_executingIndex;                /**< Index of the stage that is currently executed */
+    bool m_executingParallel;
+
+    std::unique_ptr<ThreadPool> m_threadPool;                   /**< Workers for parallel execution (nullptr if disabled) */
+    std::vector<std::vector<AbstractStage *>> m_stageLevels;    /**< Stages grouped by dependency level */
+
+    ChronoTimer::Duration m_frameBudget;    /**< Time for deferrable stages per execution (zero if unlimited) */
+    BudgetUsage m_budgetUsage;
+
+    bool m_compiled;                        /**< Execute through m_plan, rebuilding it when necessary */
+    bool m_planOutdated;                    /**< Discard m_plan after the current sweep */
+    std::unique_ptr<ExecutionPlan> m_plan;  /**< Frozen execution order (nullptr if not compiled or outdated) */
+
+    std::vector<AsyncStage *> m_asyncStages;    /**< Stages whose results have to be published */
+
+    std::unique_ptr<StageProfiler> m_profiler;  /**< Records stage executions (nullptr if disabled) */
+    std::unique_ptr<MemoryTracker> m_memoryTracker; /**< Records peak sizes of stage outputs (nullptr if disabled) */
+
+    size_t m_updateDepth;                               /**< Number of open updates */
+    std::vector<AbstractData *> m_pendingInvalidations; /**< Data invalidated during an update */
+    std::vector<AbstractStage *> m_pendingStages;       /**< Stages whose dependencies changed during an update */
 };
 
 
@@ -33,34 +33,27 @@ Data<T> * AbstractPipeline::addConstantParameter(const T & value)
 template <typename T>
 Data<T> * AbstractPipeline::getParameter(const std::string & name) const
 {
-    return dynamic_cast<Data<T> *>(findParameter(name));
+    return Data<T>::cast(findParameter(name));
 }
 
 template <typename T>
 Data<T> * AbstractPipeline::getParameter() const
 {
-    return dynamic_cast<Data<T> *>(collection::detect(m_parameters, [](AbstractData * parameter) { return dynamic_cast<Data<T> *>(parameter) != nullptr; }, nullptr));
+    updateDataIndex();
+
+    return static_cast<Data<T> *>(m_parameterIndex.findType(TypeToken<T>::id()));
 }
 
 template <typename T>
 Data<T> * AbstractPipeline::getOutput(const std::string & name) const
 {
-    for (AbstractData * output : findOutputs(name))
-    {
-        Data<T>* data = dynamic_cast<Data<T> *>(output);
-        if (data)
-        {
-            return data;
-        }
-    }
-
-    return nullptr;
+    return static_cast<Data<T> *>(findOutput(name, TypeToken<T>::id()));
 }
 
 template <typename T>
 Data<T> * AbstractPipeline::getOutput() const
 {
-    return dynamic_cast<Data<T> *>(collection::detect(allOutputs(), [](AbstractData * data) { return dynamic_cast<Data<T> *>(data) != nullptr; }, nullptr));
+    return static_cast<Data<T> *>(findOutputOfType(TypeToken<T>::id()));
 }
 
 
@@ -2,13 +2,19 @@
 #pragma once
 
 
+#include <atomic>
+#include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <signalzeug/Signal.h>
 
 #include <gloperate/base/CachedValue.h>
 
+#include <gloperate/pipeline/SlotView.h>
+#include <gloperate/pipeline/StageCache.h>
+
 #include <gloperate/gloperate_api.h>
 
 
@@ -18,6 +24,7 @@ namespace gloperate
 
 class AbstractInputSlot;
 class AbstractData;
+class AbstractPipeline;
 
 
 /**
@@ -28,12 +35,42 @@ class AbstractData;
 *    specific task in a rendering or processing technique and
 *    is executed by the pipeline if needed.
 *
+*    A stage is dirty if one of its inputs has been invalidated
+*    since it has last been processed. Stages without inputs and
+*    stages that are set to always process stay dirty.
+*
+*    Stages that are pure functions of their inputs can enable
+*    memoization. The outputs are then stored for the content
+*    hashes of the inputs and restored instead of processing
+*    when the same input values occur again. Memoization only
+*    applies if all connected inputs provide a content hash and
+*    all outputs can be copied.
+*
+*    Stages whose results may lag behind by a few frames can be
+*    marked as deferrable. If the pipeline has a frame budget, they
+*    are only processed while time is left, in order of their
+*    priority.
+*
+*    Outputs that keep a history (see HistoryData) record their
+*    current value each time before the stage is processed.
+*
+*    Inputs and outputs are kept in contiguous arrays, own slots
+*    first and shared slots after them. Own slots keep their
+*    index for the lifetime of the stage.
+*
 *  @see AbstractPipeline
 *  @see Data
 *  @see InputSlot
 */
 class GLOPERATE_API AbstractStage
 {
+    friend class AbstractData;
+    friend class AbstractInputSlot;
+    friend class AbstractPipeline;
+    friend class ExecutionPlan;
+    friend class PipelineAnalysis;
+
+
 public:
     signalzeug::Signal<> dependenciesChanged;
 
@@ -56,12 +93,25 @@ public:
     void setEnabled(bool enabled);
     bool isEnabled() const;
 
+    void setRequiresContext(bool requiresContext);
+    bool requiresContext() const;
+
+    void setDeferrable(bool deferrable);
+    bool isDeferrable() const;
+
+    void setPriority(int priority);
+    int priority() const;
+
+    void setMemoization(bool enabled, size_t capacity = 8);
+    bool memoization() const;
+    const StageCache * cache() const;
+
     bool requires(const AbstractStage * stage, bool recursive = true) const;
 
-    const std::set<AbstractData*> & outputs() const;
-    std::set<AbstractData*> allOutputs() const;
-    const std::set<AbstractInputSlot*> & inputs() const;
-    std::set<AbstractInputSlot*> allInputs() const;
+    SlotView<AbstractData*> outputs() const;
+    SlotView<AbstractData*> allOutputs() const;
+    SlotView<AbstractInputSlot*> inputs() const;
+    SlotView<AbstractInputSlot*> allInputs() const;
 
     void addOutput(const std::string & name, AbstractData & output);
     void shareOutput(AbstractData * output);
@@ -75,31 +125,49 @@ public:
     bool isAlwaysProcess() const;
     void scheduleProcess();
 
+    bool isDirty() const;
+
     void invalidateOutputs();
 
 
 protected:
+    void run();
     bool needsToProcess() const;
     bool inputsUsable() const;
     void markInputsProcessed();
+    void markDirty();
+    void outputsChanged();
+    bool inputHashes(StageCache::Key & hashes) const;
 
     virtual void process() = 0;
 
 
 protected:
     bool m_enabled;
+    bool m_requiresContext; /**< Stage has to be processed on the thread owning the OpenGL context */
+    bool m_deferrable;      /**< Processing may be postponed to a later frame if the frame budget is exhausted */
+    int m_priority;         /**< Deferred stages with higher priority are processed first */
     bool m_alwaysProcess;
     bool m_processScheduled;
     bool m_scheduledManually;
+    std::atomic<bool> m_dirty;
     std::string m_name;
     gloperate::CachedValue<bool> m_usable;
 
-    std::set<AbstractData*> m_outputs;
-    std::set<AbstractData*> m_sharedOutputs;
-    std::set<AbstractInputSlot*> m_inputs;
-    std::set<AbstractInputSlot*> m_sharedInputs;
+    std::vector<AbstractData*> m_outputs;       /**< Own outputs followed by shared outputs */
+    size_t m_numOwnOutputs;
+    std::vector<AbstractInputSlot*> m_inputs;   /**< Own inputs followed by shared inputs */
+    size_t m_numOwnInputs;
+    std::vector<AbstractData*> m_historyOutputs; /**< Own outputs that keep previous values */
     std::set<AbstractStage*> m_dependencies;    /**< Additional manual dependencies not expressed by data connections */
 
+    std::unique_ptr<StageCache> m_cache;        /**< Memoized outputs (nullptr if memoization is disabled) */
+
+    AbstractPipeline * m_pipeline;              /**< Pipeline that schedules this stage (can be nullptr) */
+    size_t m_pipelineIndex;                     /**< Position of this stage in the sorted stages of m_pipeline */
+    std::vector<AbstractStage*> m_predecessors; /**< Stages of m_pipeline this stage depends on (maintained by m_pipeline) */
+    std::vector<AbstractStage*> m_successors;   /**< Stages of m_pipeline depending on this stage (maintained by m_pipeline) */
+
 
 private:
     AbstractStage(const AbstractStage&) = delete;
@@ -0,0 +1,80 @@
+#pragma once
+
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/BufferedData.h>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+
+class ThreadPool;
+
+
+/**
+*  @brief
+*    Stage that processes on a worker thread
+*
+*    When executed, an asynchronous stage calls prepare() on the
+*    pipeline thread and then runs processAsync() on its own worker
+*    thread, so the pipeline does not wait for expensive computations.
+*
+*    Results are written into the back buffers of BufferedData outputs
+*    and published. Consumers keep reading the previous values until
+*    the pipeline swaps the buffers at the beginning of its next
+*    execution after the job has finished. If the stage is invalidated
+*    while a job is running, it is processed again after the results
+*    have been published.
+*
+*    processAsync() must not access inputs that may change meanwhile;
+*    copy the required input data in prepare() instead. Derived classes
+*    have to call wait() in their destructor.
+*
+*  @see BufferedData
+*  @see AbstractPipeline
+*/
+class GLOPERATE_API AsyncStage : public AbstractStage
+{
+public:
+    AsyncStage(const std::string & name = "");
+    virtual ~AsyncStage();
+
+    bool isProcessing() const;
+    void wait() const;
+
+    bool publish();
+
+    using AbstractStage::addOutput;
+
+    template <typename T>
+    void addOutput(const std::string & name, BufferedData<T> & output);
+
+
+protected:
+    virtual void prepare();
+    virtual void processAsync() = 0;
+
+    virtual void process() override final;
+
+
+protected:
+    std::unique_ptr<ThreadPool> m_worker;
+    std::future<void> m_result;                 /**< Result of the current job (invalid if none is pending) */
+    bool m_restartPending;                      /**< Stage has been invalidated while processing */
+    std::vector<std::function<bool()>> m_swaps; /**< Buffer swaps of the buffered outputs */
+};
+
+
+} // namespace gloperate
+
+
+#include <gloperate/pipeline/AsyncStage.hpp>
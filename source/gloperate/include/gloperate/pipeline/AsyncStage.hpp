@@ -0,0 +1,21 @@
+#pragma once
+
+
+#include <gloperate/pipeline/AsyncStage.h>
+
+
+namespace gloperate
+{
+
+
+template <typename T>
+void AsyncStage::addOutput(const std::string & name, BufferedData<T> & output)
+{
+    AbstractStage::addOutput(name, output);
+
+    BufferedData<T> * data = &output;
+    m_swaps.push_back([data]() { return data->swap(); });
+}
+
+
+} // namespace gloperate
@@ -0,0 +1,145 @@
+#pragma once
+
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+
+class AbstractData;
+class AbstractPipeline;
+
+
+/**
+*  @brief
+*    Evaluation of a pipeline for many sets of parameter values
+*
+*    Each variant assigns values to parameters, identified by name.
+*    Parameters a variant does not assign keep the values they had
+*    before the batch. The variants are ordered such that equal
+*    parameter values follow each other, and a parameter is only
+*    assigned if its value differs from the current one. Stages whose
+*    inputs do not change between variants are therefore processed
+*    only once. After each variant, copies of the requested outputs
+*    are taken, so outputs and parameters need a content hash.
+*
+*    Variants can be distributed over several equivalent pipelines,
+*    which are then evaluated on separate threads. This requires that
+*    no stage of the pipelines needs the OpenGL context.
+*
+*    \code{.cpp}
+*
+*        std::vector<BatchEvaluation::Parameters> variants(2);
+*        variants[0].set("width", 128);
+*        variants[1].set("width", 256);
+*
+*        BatchEvaluation batch({ "ThumbnailStage::image" });
+*        auto results = batch.run(pipeline, variants);
+*        const Image * image = results[1].get<Image>("ThumbnailStage::image");
+*
+*    \endcode
+*
+*  @see AbstractPipeline::evaluate
+*/
+class GLOPERATE_API BatchEvaluation
+{
+public:
+    /**
+    *  @brief
+    *    Parameter values of one variant
+    */
+    class GLOPERATE_API Parameters
+    {
+    public:
+        template <typename T>
+        void set(const std::string & name, const T & value);
+
+        const std::map<std::string, std::shared_ptr<AbstractData>> & values() const;
+
+    protected:
+        std::map<std::string, std::shared_ptr<AbstractData>> m_values;
+    };
+
+    /**
+    *  @brief
+    *    Copies of the outputs after evaluating one variant
+    */
+    class GLOPERATE_API Outputs
+    {
+    public:
+        const AbstractData * output(const std::string & name) const;
+
+        template <typename T>
+        const T * get(const std::string & name) const;
+
+        void set(const std::string & name, const std::shared_ptr<AbstractData> & value);
+
+    protected:
+        std::map<std::string, std::shared_ptr<AbstractData>> m_values;
+    };
+
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] outputNames
+    *    Names or qualified names of the outputs to evaluate
+    */
+    explicit BatchEvaluation(const std::vector<std::string> & outputNames);
+    virtual ~BatchEvaluation();
+
+    const std::vector<std::string> & outputNames() const;
+
+    /**
+    *  @brief
+    *    Evaluate all variants on one pipeline
+    *
+    *  @param[in] pipeline
+    *    Pipeline (its parameters are reset to their previous values afterwards)
+    *  @param[in] variants
+    *    Parameter values of the variants
+    *
+    *  @return
+    *    Outputs of each variant, in the order of the variants
+    */
+    std::vector<Outputs> run(AbstractPipeline & pipeline, const std::vector<Parameters> & variants) const;
+
+    /**
+    *  @brief
+    *    Evaluate the variants distributed over equivalent pipelines
+    *
+    *  @param[in] pipelines
+    *    Pipelines with the same structure that do not share any data
+    *  @param[in] variants
+    *    Parameter values of the variants
+    *
+    *  @return
+    *    Outputs of each variant, in the order of the variants
+    */
+    std::vector<Outputs> run(const std::vector<AbstractPipeline *> & pipelines, const std::vector<Parameters> & variants) const;
+
+
+protected:
+    std::vector<size_t> order(const std::vector<Parameters> & variants) const;
+    void run(AbstractPipeline & pipeline, const std::vector<Parameters> & variants,
+        const std::vector<size_t> & indices, std::vector<Outputs> & results) const;
+
+
+protected:
+    std::vector<std::string> m_outputNames;
+};
+
+
+} // namespace gloperate
+
+
+#include <gloperate/pipeline/BatchEvaluation.hpp>
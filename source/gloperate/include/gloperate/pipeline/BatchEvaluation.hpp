@@ -0,0 +1,27 @@
+#pragma once
+
+
+#include <gloperate/pipeline/BatchEvaluation.h>
+#include <gloperate/pipeline/Data.h>
+
+
+namespace gloperate
+{
+
+
+template <typename T>
+void BatchEvaluation::Parameters::set(const std::string & name, const T & value)
+{
+    m_values[name] = std::make_shared<Data<T>>(value);
+}
+
+template <typename T>
+const T * BatchEvaluation::Outputs::get(const std::string & name) const
+{
+    auto data = Data<T>::cast(output(name));
+
+    return data ? &data->data() : nullptr;
+}
+
+
+} // namespace gloperate
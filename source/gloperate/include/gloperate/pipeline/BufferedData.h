@@ -0,0 +1,57 @@
+#pragma once
+
+
+#include <atomic>
+
+#include <gloperate/pipeline/Data.h>
+
+
+namespace gloperate
+{
+
+
+/**
+*  @brief
+*    Double-buffered data container
+*
+*    Consumers always read the front buffer, which holds the last
+*    published value. A producer running on another thread writes
+*    the complete new value into back() and calls publish(). The
+*    buffers are exchanged by swap() on the pipeline thread, which
+*    also invalidates the data, so consumers never observe a value
+*    that is only partially written.
+*
+*  @see AsyncStage
+*/
+template <typename T>
+class BufferedData : public Data<T>
+{
+public:
+    BufferedData();
+
+    template <typename... Args>
+    explicit BufferedData(Args&&... args);
+
+    using Data<T>::operator=;
+
+    T & back();
+    const T & back() const;
+
+    void publish();
+    bool isPublished() const;
+
+    bool swap();
+
+    virtual size_t sizeInBytes() const override;
+
+
+protected:
+    T m_back;
+    std::atomic<bool> m_published;
+};
+
+
+} // namespace gloperate
+
+
+#include <gloperate/pipeline/BufferedData.hpp>
@@ -0,0 +1,75 @@
+#pragma once
+
+
+#include <utility>
+
+#include <gloperate/pipeline/BufferedData.h>
+
+
+namespace gloperate
+{
+
+
+template <typename T>
+BufferedData<T>::BufferedData()
+: Data<T>()
+, m_back()
+, m_published(false)
+{
+}
+
+template <typename T>
+template <typename... Args>
+BufferedData<T>::BufferedData(Args&&... args)
+: Data<T>(std::forward<Args>(args)...)
+, m_back()
+, m_published(false)
+{
+}
+
+template <typename T>
+T & BufferedData<T>::back()
+{
+    return m_back;
+}
+
+template <typename T>
+const T & BufferedData<T>::back() const
+{
+    return m_back;
+}
+
+template <typename T>
+void BufferedData<T>::publish()
+{
+    m_published.store(true, std::memory_order_release);
+}
+
+template <typename T>
+bool BufferedData<T>::isPublished() const
+{
+    return m_published.load(std::memory_order_acquire);
+}
+
+template <typename T>
+bool BufferedData<T>::swap()
+{
+    if (!m_published.exchange(false, std::memory_order_acq_rel))
+        return false;
+
+    std::swap(this->m_data, m_back);
+    this->m_hashValid = false;
+    this->invalidate();
+
+    return true;
+}
+
+template <typename T>
+size_t BufferedData<T>::sizeInBytes() const
+{
+    // The back buffer may be written by the producer, it is assumed to be as large as the front buffer
+    return 2 * Data<T>::sizeInBytes();
+}
+
+
+} // namespace gloperate
@@ -2,9 +2,14 @@
 #pragma once
 
 
+#include <functional>
+#include <memory>
 #include <string>
+#include <type_traits>
 
 #include <gloperate/pipeline/AbstractData.h>
+#include <gloperate/pipeline/DataSize.h>
+#include <gloperate/pipeline/TypeToken.h>
 
 
 namespace gloperate 
@@ -21,6 +26,25 @@ namespace gloperate
 *    of pipelines to promote data and control the order and
 *    execution of pipeline stages based on data flow.
 *
+*    Setting a value always invalidates the data by default.
+*    Optionally, the data only invalidates if the new value differs
+*    from the current one, compared by operator== or by a hash
+*    function. This keeps redundant updates, e.g., from user
+*    interfaces, from triggering the execution of the pipeline.
+*
+*    The content hash used for memoization is provided for
+*    arithmetic types, enums, and strings. Other types need a
+*    hash function to take part in memoization.
+*
+*    Snapshots, i.e., copies of the value taken by memoization and
+*    batch evaluation, are only supported for values with a content
+*    hash. Setting a hash function thereby also states that copying
+*    the value is safe, which is not the case for every copyable
+*    type, e.g., containers owning raw pointers.
+*
+*    The memory held by the value is determined by DataSize<T>,
+*    which can be specialized for types that own memory.
+*
 *  @see InputSlot
 *  @see AbstractStage
 *  @see AbstractPipeline
@@ -28,6 +52,24 @@ namespace gloperate
 template <typename T>
 class Data : public AbstractData
 {
+public:
+    /**
+    *  @brief
+    *    Cast a data container to this type
+    *
+    *  @param[in] data
+    *    Data container (can be nullptr)
+    *
+    *  @return
+    *    Typed data container, nullptr if the type ids differ
+    *
+    *  @remarks
+    *    Compares the type ids instead of using dynamic_cast, so it
+    *    also works for data created in other modules.
+    */
+    static Data<T> * cast(AbstractData * data);
+    static const Data<T> * cast(const AbstractData * data);
+
 public:
     Data();
 
@@ -46,13 +88,68 @@ public:
 
     Data<T> & operator=(const Data<T> & data);
     const T & operator=(const T & value);
+    const T & operator=(T && value);
 
     void setData(const T & value);
+    void setData(T && value);
+
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    /**
+    *  @brief
+    *    Modify the data in place and invalidate it once
+    *
+    *  @param[in] function
+    *    Function that is called with a reference to the data
+    *
+    *  @remarks
+    *    If only changes are to be propagated, modifications are
+    *    detected by the hash function. Without hash function, the
+    *    data is invalidated in any case to avoid copying the value.
+    */
+    template <typename Function>
+    void modify(Function function);
+
+    void setInvalidateOnlyIfChanged(bool enabled);
+    void setHashFunction(const std::function<size_t(const T &)> & hash);
+    bool invalidatesOnlyIfChanged() const;
 
     virtual std::string type() const override;
+
+    virtual bool contentHash(size_t & hash) const override;
+    virtual bool canSnapshot() const override;
+    virtual std::shared_ptr<AbstractData> snapshot() const override;
+    virtual bool restore(const AbstractData & snapshot) override;
+
+    virtual size_t sizeInBytes() const override;
     
+protected:
+    using HashCategory = std::integral_constant<int,
+        std::is_enum<T>::value ? 2 : (std::is_arithmetic<T>::value || std::is_same<T, std::string>::value ? 1 : 0)>;
+    using Copyable = std::integral_constant<bool,
+        std::is_copy_constructible<T>::value && std::is_copy_assignable<T>::value>;
+
+    bool changes(const T & value) const;
+    size_t hashValue() const;
+
+    static bool defaultHash(const T & value, size_t & hash, std::integral_constant<int, 0>);
+    static bool defaultHash(const T & value, size_t & hash, std::integral_constant<int, 1>);
+    static bool defaultHash(const T & value, size_t & hash, std::integral_constant<int, 2>);
+
+    std::shared_ptr<AbstractData> snapshot(std::false_type) const;
+    std::shared_ptr<AbstractData> snapshot(std::true_type) const;
+    bool restore(const AbstractData & snapshot, std::false_type);
+    bool restore(const AbstractData & snapshot, std::true_type);
+
+
 protected:
     T m_data;
+
+    std::function<bool(const T &, const T &)> m_equal;  /**< Comparison of values (empty if not used) */
+    std::function<size_t(const T &)> m_hash;            /**< Hash of values (empty if not used) */
+    mutable size_t m_hashValue;                         /**< Hash of m_data if m_hashValid */
+    mutable bool m_hashValid;
 };
 
 
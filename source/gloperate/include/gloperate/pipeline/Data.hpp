@@ -2,6 +2,8 @@
 #pragma once
 
 
+#include <utility>
+
 #include <gloperate/pipeline/Data.h>
 
 
@@ -9,22 +11,43 @@ namespace gloperate
 {
 
 
+template <typename T>
+Data<T> * Data<T>::cast(AbstractData * data)
+{
+    return data && data->typeId() == TypeToken<T>::id() ? static_cast<Data<T> *>(data) : nullptr;
+}
+
+template <typename T>
+const Data<T> * Data<T>::cast(const AbstractData * data)
+{
+    return data && data->typeId() == TypeToken<T>::id() ? static_cast<const Data<T> *>(data) : nullptr;
+}
+
 template <typename T>
 Data<T>::Data()
 : m_data()
+, m_hashValue(0)
+, m_hashValid(false)
 {
+    m_typeId = TypeToken<T>::id();
 }
 
 template <typename T>
 template <typename... Args>
 Data<T>::Data(Args&&... args)
 : m_data(std::forward<Args>(args)...)
+, m_hashValue(0)
+, m_hashValid(false)
 {
+    m_typeId = TypeToken<T>::id();
 }
 
 template <typename T>
 T & Data<T>::data()
 {
+    // The value may be modified through the reference
+    m_hashValid = false;
+
     return m_data;
 }
 
@@ -37,6 +60,9 @@ const T & Data<T>::data() const
 template <typename T>
 T & Data<T>::operator*()
 {
+    // The value may be modified through the reference
+    m_hashValid = false;
+
     return m_data;
 }
 
@@ -49,6 +75,9 @@ const T & Data<T>::operator*() const
 template <typename T>
 T * Data<T>::operator->()
 {
+    // The value may be modified through the reference
+    m_hashValid = false;
+
     return &m_data;
 }
 
@@ -75,23 +104,225 @@ Data<T> & Data<T>::operator=(const Data<T> & data)
 template <typename T>
 const T & Data<T>::operator=(const T & value)
 {
-    m_data = value;
-    invalidate();
+    setData(value);
 
     return value;
 }
 
+template <typename T>
+const T & Data<T>::operator=(T && value)
+{
+    setData(std::move(value));
+
+    return m_data;
+}
+
 template <typename T>
 void Data<T>::setData(const T & value)
 {
+    if (!changes(value))
+        return;
+
     m_data = value;
     invalidate();
 }
 
+template <typename T>
+void Data<T>::setData(T && value)
+{
+    if (!changes(value))
+        return;
+
+    m_data = std::move(value);
+    invalidate();
+}
+
+template <typename T>
+template <typename... Args>
+void Data<T>::emplace(Args&&... args)
+{
+    setData(T(std::forward<Args>(args)...));
+}
+
+template <typename T>
+template <typename Function>
+void Data<T>::modify(Function function)
+{
+    if (!m_hash)
+    {
+        function(m_data);
+        invalidate();
+        return;
+    }
+
+    const size_t previousHash = hashValue();
+
+    function(m_data);
+
+    m_hashValue = m_hash(m_data);
+
+    if (m_hashValue != previousHash)
+        invalidate();
+}
+
+template <typename T>
+void Data<T>::setInvalidateOnlyIfChanged(bool enabled)
+{
+    m_hash = nullptr;
+    m_hashValid = false;
+
+    if (enabled)
+    {
+        m_equal = [](const T & lhs, const T & rhs) { return lhs == rhs; };
+    }
+    else
+    {
+        m_equal = nullptr;
+    }
+}
+
+template <typename T>
+void Data<T>::setHashFunction(const std::function<size_t(const T &)> & hash)
+{
+    m_equal = nullptr;
+    m_hash = hash;
+    m_hashValid = false;
+}
+
+template <typename T>
+bool Data<T>::invalidatesOnlyIfChanged() const
+{
+    return m_equal || m_hash;
+}
+
+template <typename T>
+bool Data<T>::changes(const T & value) const
+{
+    if (m_hash)
+    {
+        const size_t previousHash = hashValue();
+
+        // The value is assigned after a change, so its hash stays valid
+        m_hashValue = m_hash(value);
+
+        return m_hashValue != previousHash;
+    }
+
+    if (m_equal)
+        return !m_equal(m_data, value);
+
+    return true;
+}
+
+template <typename T>
+size_t Data<T>::hashValue() const
+{
+    if (!m_hashValid)
+    {
+        m_hashValue = m_hash(m_data);
+        m_hashValid = true;
+    }
+
+    return m_hashValue;
+}
+
 template <typename T>
 std::string Data<T>::type() const 
 {
-    return typeid(T).name(); 
+    return TypeToken<T>::name();
+}
+
+template <typename T>
+bool Data<T>::contentHash(size_t & hash) const
+{
+    if (m_hash)
+    {
+        hash = hashValue();
+        return true;
+    }
+
+    return defaultHash(m_data, hash, HashCategory());
+}
+
+template <typename T>
+bool Data<T>::canSnapshot() const
+{
+    return Copyable::value && (m_hash || HashCategory::value != 0);
+}
+
+template <typename T>
+std::shared_ptr<AbstractData> Data<T>::snapshot() const
+{
+    if (!canSnapshot())
+        return nullptr;
+
+    return snapshot(Copyable());
+}
+
+template <typename T>
+bool Data<T>::restore(const AbstractData & snapshot)
+{
+    if (!canSnapshot())
+        return false;
+
+    return restore(snapshot, Copyable());
+}
+
+template <typename T>
+size_t Data<T>::sizeInBytes() const
+{
+    return DataSize<T>::sizeInBytes(m_data);
+}
+
+template <typename T>
+bool Data<T>::defaultHash(const T & /*value*/, size_t & /*hash*/, std::integral_constant<int, 0>)
+{
+    return false;
+}
+
+template <typename T>
+bool Data<T>::defaultHash(const T & value, size_t & hash, std::integral_constant<int, 1>)
+{
+    hash = std::hash<T>()(value);
+    return true;
+}
+
+template <typename T>
+bool Data<T>::defaultHash(const T & value, size_t & hash, std::integral_constant<int, 2>)
+{
+    hash = static_cast<size_t>(value);
+    return true;
+}
+
+template <typename T>
+std::shared_ptr<AbstractData> Data<T>::snapshot(std::false_type) const
+{
+    return nullptr;
+}
+
+template <typename T>
+std::shared_ptr<AbstractData> Data<T>::snapshot(std::true_type) const
+{
+    return std::make_shared<Data<T>>(m_data);
+}
+
+template <typename T>
+bool Data<T>::restore(const AbstractData & /*snapshot*/, std::false_type)
+{
+    return false;
+}
+
+template <typename T>
+bool Data<T>::restore(const AbstractData & snapshot, std::true_type)
+{
+    auto data = cast(&snapshot);
+
+    if (!data)
+        return false;
+
+    setData(data->m_data);
+
+    return true;
 }
 
     
@@ -0,0 +1,48 @@
+#pragma once
+
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+
+class AbstractData;
+
+
+/**
+*  @brief
+*    Hash index of data containers by name and type
+*
+*    Each data container is indexed by its name, its qualified
+*    name, and its type. Entries with the same key keep the order
+*    in which they have been added.
+*
+*  @see AbstractPipeline
+*/
+class GLOPERATE_API DataIndex
+{
+public:
+    DataIndex();
+    virtual ~DataIndex();
+
+    void add(AbstractData * data);
+    void clear();
+
+    const std::vector<AbstractData *> & find(const std::string & name) const;
+    AbstractData * find(const std::string & name, size_t typeId) const;
+    AbstractData * findType(size_t typeId) const;
+
+
+protected:
+    std::unordered_map<std::string, std::vector<AbstractData *>> m_names;
+    std::unordered_map<size_t, std::vector<AbstractData *>> m_types;
+};
+
+
+} // namespace gloperate
@@ -0,0 +1,100 @@
+#pragma once
+
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace globjects
+{
+
+template <typename T>
+class ref_ptr;
+
+class Buffer;
+class Texture;
+
+}
+
+
+namespace gloperate
+{
+
+
+/**
+*  @brief
+*    Memory held by a value of a data container
+*
+*    The size of a value is the size of the object itself plus the
+*    memory it owns on the heap or on the GPU. By default, only the
+*    object itself is counted. Types that own additional memory
+*    specialize DataSize, which is then used by Data<T>.
+*
+*    \code{.cpp}
+*
+*        template <>
+*        struct DataSize<Mesh>
+*        {
+*            static size_t sizeInBytes(const Mesh & mesh)
+*            {
+*                return sizeof(Mesh) + DataSize<std::vector<glm::vec3>>::sizeInBytes(mesh.vertices);
+*            }
+*        };
+*
+*    \endcode
+*
+*    Sizes of textures and buffers are queried from OpenGL, so they
+*    must only be determined while the context is current.
+*
+*  @see AbstractData::sizeInBytes
+*/
+template <typename T>
+struct DataSize
+{
+    static size_t sizeInBytes(const T & value);
+};
+
+template <typename T, typename Allocator>
+struct DataSize<std::vector<T, Allocator>>
+{
+    static size_t sizeInBytes(const std::vector<T, Allocator> & value);
+};
+
+template <typename Char, typename Traits, typename Allocator>
+struct DataSize<std::basic_string<Char, Traits, Allocator>>
+{
+    static size_t sizeInBytes(const std::basic_string<Char, Traits, Allocator> & value);
+};
+
+template <>
+struct GLOPERATE_API DataSize<globjects::Texture *>
+{
+    static size_t sizeInBytes(const globjects::Texture * texture);
+};
+
+template <>
+struct GLOPERATE_API DataSize<globjects::ref_ptr<globjects::Texture>>
+{
+    static size_t sizeInBytes(const globjects::ref_ptr<globjects::Texture> & texture);
+};
+
+template <>
+struct GLOPERATE_API DataSize<globjects::Buffer *>
+{
+    static size_t sizeInBytes(const globjects::Buffer * buffer);
+};
+
+template <>
+struct GLOPERATE_API DataSize<globjects::ref_ptr<globjects::Buffer>>
+{
+    static size_t sizeInBytes(const globjects::ref_ptr<globjects::Buffer> & buffer);
+};
+
+
+} // namespace gloperate
+
+
+#include <gloperate/pipeline/DataSize.hpp>
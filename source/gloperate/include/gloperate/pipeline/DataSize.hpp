@@ -0,0 +1,38 @@
+#pragma once
+
+
+#include <gloperate/pipeline/DataSize.h>
+
+
+namespace gloperate
+{
+
+
+template <typename T>
+size_t DataSize<T>::sizeInBytes(const T & /*value*/)
+{
+    return sizeof(T);
+}
+
+template <typename T, typename Allocator>
+size_t DataSize<std::vector<T, Allocator>>::sizeInBytes(const std::vector<T, Allocator> & value)
+{
+    // Reserved elements are counted as well
+    size_t size = sizeof(value) + (value.capacity() - value.size()) * sizeof(T);
+
+    for (const auto & element : value)
+    {
+        size += DataSize<T>::sizeInBytes(element);
+    }
+
+    return size;
+}
+
+template <typename Char, typename Traits, typename Allocator>
+size_t DataSize<std::basic_string<Char, Traits, Allocator>>::sizeInBytes(const std::basic_string<Char, Traits, Allocator> & value)
+{
+    return sizeof(value) + value.capacity() * sizeof(Char);
+}
+
+
+} // namespace gloperate
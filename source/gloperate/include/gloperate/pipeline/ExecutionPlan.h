@@ -0,0 +1,93 @@
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+
+class AbstractStage;
+
+
+/**
+*  @brief
+*    Frozen execution order of a pipeline
+*
+*    An execution plan stores the stages of a sorted pipeline in a
+*    flat array together with their usability, which is resolved
+*    once when the plan is created. Dirty stages are tracked in a
+*    bitmask indexed by position, so finding the next stage to
+*    execute is a bit scan instead of a heap operation.
+*
+*    A plan is only valid as long as the stages, their order, and
+*    their connections do not change. The pipeline discards it on
+*    every such change.
+*
+*  @see AbstractPipeline::compile
+*/
+class GLOPERATE_API ExecutionPlan
+{
+public:
+    static const size_t npos;
+
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] stages
+    *    Stages in topological order
+    */
+    explicit ExecutionPlan(const std::vector<AbstractStage *> & stages);
+    virtual ~ExecutionPlan();
+
+    size_t size() const;
+
+    AbstractStage * stage(size_t index) const;
+    bool isUsable(size_t index) const;
+
+    void schedule(size_t index);
+    void unschedule(size_t index);
+    bool isScheduled(size_t index) const;
+
+    /**
+    *  @brief
+    *    Schedule exactly the stages that are dirty
+    */
+    void reschedule();
+
+    /**
+    *  @brief
+    *    Find the first scheduled stage at or after a position
+    *
+    *  @param[in] index
+    *    Position to start at
+    *
+    *  @return
+    *    Position of the stage, npos if there is none
+    */
+    size_t nextScheduled(size_t index) const;
+
+
+protected:
+    struct Step
+    {
+        AbstractStage * stage;
+        bool usable;    /**< All inputs of the stage are usable */
+    };
+
+
+protected:
+    std::vector<Step> m_steps;
+    std::vector<std::uint64_t> m_scheduled;  /**< One bit per step */
+};
+
+
+} // namespace gloperate
@@ -0,0 +1,61 @@
+#pragma once
+
+
+#include <gloperate/pipeline/HistoryData.h>
+#include <gloperate/pipeline/InputSlot.h>
+
+
+namespace gloperate
+{
+
+
+/**
+*  @brief
+*    Input slot that reads previous values of a HistoryData
+*
+*    A feedback slot does not make its stage depend on the
+*    connected data, so it can be connected to outputs of the
+*    same or later stages. Besides the current value, it provides
+*    the values of the last N executions of the producing stage.
+*    Connected to plain data, only the current value is available.
+*
+*  @see HistoryData
+*  @see AbstractStage::addFeedbackInput
+*/
+template <typename T, size_t N>
+class FeedbackSlot : public InputSlot<T>
+{
+public:
+    FeedbackSlot();
+    virtual ~FeedbackSlot();
+
+    using InputSlot<T>::operator=;
+
+    /**
+    *  @brief
+    *    Get a previous value of the connected data
+    *
+    *  @param[in] framesAgo
+    *    Number of executions of the producer ago (1 to N)
+    *
+    *  @return
+    *    Previous value, current value if the data has no history
+    */
+    const T & previous(size_t framesAgo = 1) const;
+
+    size_t historySize() const;
+
+
+protected:
+    virtual void dataDestroyed() override;
+
+
+protected:
+    const HistoryData<T, N> * m_history;    /**< Connected data if it keeps a history, else nullptr */
+};
+
+
+} // namespace gloperate
+
+
+#include <gloperate/pipeline/FeedbackSlot.hpp>
@@ -0,0 +1,52 @@
+#pragma once
+
+
+#include <gloperate/pipeline/FeedbackSlot.h>
+
+
+namespace gloperate
+{
+
+
+template <typename T, size_t N>
+FeedbackSlot<T, N>::FeedbackSlot()
+: InputSlot<T>()
+, m_history(nullptr)
+{
+    this->setFeedback(true);
+
+    this->connectionChanged.connect([this]()
+    {
+        // The type id and history length identify HistoryData<T, N>, as for InputSlot::matchType
+        const AbstractData * data = this->m_data;
+        m_history = data && this->matchType(*data) && data->historyLength() == N ? static_cast<const HistoryData<T, N> *>(data) : nullptr;
+    });
+}
+
+template <typename T, size_t N>
+FeedbackSlot<T, N>::~FeedbackSlot()
+{
+}
+
+template <typename T, size_t N>
+const T & FeedbackSlot<T, N>::previous(size_t framesAgo) const
+{
+    return m_history ? m_history->previous(framesAgo) : this->data();
+}
+
+template <typename T, size_t N>
+size_t FeedbackSlot<T, N>::historySize() const
+{
+    return m_history ? m_history->historySize() : 0;
+}
+
+template <typename T, size_t N>
+void FeedbackSlot<T, N>::dataDestroyed()
+{
+    m_history = nullptr;
+
+    InputSlot<T>::dataDestroyed();
+}
+
+
+} // namespace gloperate
@@ -0,0 +1,74 @@
+#pragma once
+
+
+#include <array>
+
+#include <gloperate/pipeline/Data.h>
+
+
+namespace gloperate
+{
+
+
+/**
+*  @brief
+*    Data container that keeps its values of previous executions
+*
+*    The last N values are kept in a preallocated ring. Each time
+*    the owning stage is about to process, the current value is
+*    copied into the ring, replacing the oldest value. The current
+*    value stays in place, so the owning stage can update data()
+*    in part. Copy assignment reuses the storage of the oldest
+*    value, e.g., the capacity of a vector.
+*
+*    Previous values that have not been recorded yet are
+*    default-constructed. Stages read them through FeedbackSlot.
+*
+*  @see FeedbackSlot
+*/
+template <typename T, size_t N>
+class HistoryData : public Data<T>
+{
+    static_assert(N > 0, "History has to hold at least one value");
+
+
+public:
+    HistoryData();
+
+    template <typename... Args>
+    explicit HistoryData(Args&&... args);
+
+    using Data<T>::operator=;
+
+    /**
+    *  @brief
+    *    Get a previous value
+    *
+    *  @param[in] framesAgo
+    *    Number of executions of the owner ago (1 to N)
+    *
+    *  @return
+    *    Value of that execution
+    */
+    const T & previous(size_t framesAgo = 1) const;
+
+    size_t historySize() const;
+
+    virtual bool hasHistory() const override;
+    virtual size_t historyLength() const override;
+    virtual void advanceHistory() override;
+
+    virtual size_t sizeInBytes() const override;
+
+
+protected:
+    std::array<T, N> m_history;
+    size_t m_head;      /**< Position of the value of the previous execution */
+    size_t m_recorded;  /**< Number of recorded values (at most N) */
+};
+
+
+} // namespace gloperate
+
+
+#include <gloperate/pipeline/HistoryData.hpp>
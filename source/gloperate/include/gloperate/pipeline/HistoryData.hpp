@@ -0,0 +1,85 @@
+#pragma once
+
+
+#include <cassert>
+#include <utility>
+
+#include <gloperate/pipeline/HistoryData.h>
+
+
+namespace gloperate
+{
+
+
+template <typename T, size_t N>
+HistoryData<T, N>::HistoryData()
+: Data<T>()
+, m_history()
+, m_head(0)
+, m_recorded(0)
+{
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+HistoryData<T, N>::HistoryData(Args&&... args)
+: Data<T>(std::forward<Args>(args)...)
+, m_history()
+, m_head(0)
+, m_recorded(0)
+{
+}
+
+template <typename T, size_t N>
+const T & HistoryData<T, N>::previous(size_t framesAgo) const
+{
+    assert(framesAgo >= 1 && framesAgo <= N);
+
+    return m_history[(m_head + N - (framesAgo - 1)) % N];
+}
+
+template <typename T, size_t N>
+size_t HistoryData<T, N>::historySize() const
+{
+    return m_recorded;
+}
+
+template <typename T, size_t N>
+bool HistoryData<T, N>::hasHistory() const
+{
+    return true;
+}
+
+template <typename T, size_t N>
+size_t HistoryData<T, N>::historyLength() const
+{
+    return N;
+}
+
+template <typename T, size_t N>
+void HistoryData<T, N>::advanceHistory()
+{
+    m_head = (m_head + 1) % N;
+
+    // The current value is kept, so owners may update it in part; assignment reuses the storage of the oldest value
+    m_history[m_head] = this->m_data;
+
+    if (m_recorded < N)
+        ++m_recorded;
+}
+
+template <typename T, size_t N>
+size_t HistoryData<T, N>::sizeInBytes() const
+{
+    size_t size = Data<T>::sizeInBytes();
+
+    for (const T & value : m_history)
+    {
+        size += DataSize<T>::sizeInBytes(value);
+    }
+
+    return size;
+}
+
+
+} // namespace gloperate
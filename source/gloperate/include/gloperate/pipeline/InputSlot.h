@@ -2,8 +2,6 @@
 #pragma once
 
 
-#include <signalzeug/ScopedConnection.h>
-
 #include <gloperate/pipeline/AbstractInputSlot.h>
 #include <gloperate/pipeline/Data.h>
 
@@ -26,6 +24,9 @@ void GLOPERATE_API printIncompatibleMessage(
 *    informed when the connection is changed or the connected
 *    data has been modified.
 *
+*    Whether data can be connected is decided by comparing type
+*    ids (see TypeToken), so no RTTI is needed for connecting.
+*
 *  @see Data
 *  @see AbstractStage
 *  @see AbstractPipeline
@@ -35,6 +36,7 @@ class InputSlot : public AbstractInputSlot
 {
 public:
     InputSlot();
+    virtual ~InputSlot();
 
     const T & data() const;
     const T & data(const T & defaultValue) const;
@@ -57,10 +59,11 @@ protected:
     template <typename U>
     void connect(const Data<U> & data);
 
+    virtual void dataDestroyed() override;
+
 
 protected:
     const Data<T> * m_data;
-    signalzeug::ScopedConnection m_connection;
 
     static const T s_defaultValue;
 };
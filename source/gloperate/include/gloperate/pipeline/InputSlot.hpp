@@ -2,7 +2,6 @@
 #pragma once
 
 
-#include <typeinfo>
 #include <type_traits>
 
 #include <gloperate/pipeline/InputSlot.h>
@@ -19,6 +18,16 @@ template <typename T>
 InputSlot<T>::InputSlot()
 : m_data(nullptr)
 {
+    m_typeId = TypeToken<T>::id();
+}
+
+template <typename T>
+InputSlot<T>::~InputSlot()
+{
+    if (m_data)
+    {
+        unregisterAt(*m_data);
+    }
 }
 
 template <typename T>
@@ -48,15 +57,13 @@ const T * InputSlot<T>::operator->() const
 template <typename T>
 bool InputSlot<T>::connectTo(const AbstractData & data)
 {
-    const Data<T> * data_ptr = dynamic_cast<const Data<T> *>(&data);
-    
-    if (!data_ptr)
+    if (!matchType(data))
     {
-        printIncompatibleMessage(this, typeid(T).name(), data);
+        printIncompatibleMessage(this, TypeToken<T>::name(), data);
         return false;
     }
     
-    connect(*data_ptr);
+    connect(static_cast<const Data<T> &>(data));
     
     return true;
 }
@@ -64,9 +71,7 @@ bool InputSlot<T>::connectTo(const AbstractData & data)
 template <typename T>
 bool InputSlot<T>::matchType(const AbstractData & data)
 {
-    const Data<T> * data_ptr = dynamic_cast<const Data<T> *>(&data);
-
-    return data_ptr != nullptr;
+    return data.typeId() == m_typeId;
 }
 
 template <typename T>
@@ -99,12 +104,24 @@ void InputSlot<T>::connect(const Data<U> & data)
 
     static_assert(std::is_same<T, U>::value || (std::is_pointer<T>::value && std::is_pointer<U>::value && std::is_base_of<Tp, Up>::value), "Types incompatible");
 
+    if (m_data)
+    {
+        unregisterAt(*m_data);
+    }
+
     m_data = reinterpret_cast<const Data<T> *>(&data);
-    m_connection = data.invalidated.connect([this]() { this->changed(); });
+    registerAt(*m_data);
+
     connectionChanged();
     changed();
 }
 
+template <typename T>
+void InputSlot<T>::dataDestroyed()
+{
+    m_data = nullptr;
+}
+
 template <typename T>
 const AbstractData * InputSlot<T>::connectedData() const
 {
@@ -0,0 +1,66 @@
+#pragma once
+
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+
+/**
+*  @brief
+*    Memory held by the parameters and stages of a pipeline
+*
+*    Sizes are determined by AbstractData::sizeInBytes(). Peaks are
+*    the largest sizes observed while memory tracking was enabled,
+*    or the current sizes otherwise.
+*
+*    Outputs without consumers and outputs of disabled stages are
+*    flagged, as they usually hold payloads that are not needed.
+*
+*  @see AbstractPipeline::memoryReport
+*/
+struct GLOPERATE_API MemoryReport
+{
+    struct Item
+    {
+        std::string name;
+        size_t bytes;
+        size_t peakBytes;
+        bool connected;     /**< Item is read by an input slot */
+    };
+
+    struct Stage
+    {
+        std::string name;
+        size_t bytes;       /**< Outputs and memoized outputs */
+        size_t peakBytes;
+        size_t cacheBytes;  /**< Memoized outputs */
+        bool enabled;
+        std::vector<Item> outputs;
+    };
+
+    std::vector<Item> parameters;
+    std::vector<Stage> stages;
+    size_t totalBytes;
+    size_t peakBytes;
+
+    MemoryReport();
+
+    /**
+    *  @brief
+    *    Write a table of the stages and their outputs, largest first
+    *
+    *  @param[in] stream
+    *    Output stream
+    */
+    void writeSummary(std::ostream & stream) const;
+};
+
+
+} // namespace gloperate
@@ -0,0 +1,65 @@
+#pragma once
+
+
+#include <mutex>
+#include <unordered_map>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+
+class AbstractData;
+class AbstractStage;
+
+
+/**
+*  @brief
+*    Records the largest memory sizes of the stages of a pipeline
+*
+*    After each execution of a stage, the sizes of its outputs and
+*    of its memoized outputs are measured. The tracker keeps the
+*    peak of each output, of each stage, and of the sum over all
+*    recorded stages.
+*
+*    Measuring the size of textures and buffers queries OpenGL, so
+*    tracking is only enabled on demand. Recording is thread-safe.
+*
+*  @see AbstractPipeline::setMemoryTracking
+*/
+class GLOPERATE_API MemoryTracker
+{
+public:
+    MemoryTracker();
+    virtual ~MemoryTracker();
+
+    /**
+    *  @brief
+    *    Measure the outputs of a stage and update the peaks
+    *
+    *  @param[in] stage
+    *    Stage that has been executed
+    */
+    void recordStage(const AbstractStage & stage);
+
+    size_t peakBytes() const;
+    size_t peakBytes(const AbstractStage * stage) const;
+    size_t peakBytes(const AbstractData * data) const;
+
+    void reset();
+
+
+protected:
+    std::unordered_map<const AbstractData *, size_t> m_dataPeaks;
+    std::unordered_map<const AbstractStage *, size_t> m_stagePeaks;
+    std::unordered_map<const AbstractStage *, size_t> m_stageSizes;  /**< Last measured size of each stage */
+    size_t m_totalBytes;    /**< Sum of m_stageSizes */
+    size_t m_peakBytes;
+
+    mutable std::mutex m_mutex;
+};
+
+
+} // namespace gloperate
@@ -0,0 +1,151 @@
+#pragma once
+
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <signalzeug/Signal.h>
+
+#include <gloperate/base/ChronoTimer.h>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace reflectionzeug
+{
+    class AbstractValueProperty;
+}
+
+
+namespace gloperate
+{
+
+
+class AbstractData;
+
+template <typename T>
+class Data;
+
+
+/**
+*  @brief
+*    Records the changes of pipeline parameters into a binary log
+*
+*    Each time a registered parameter is invalidated, its value is
+*    serialized by a reflectionzeug property and written to the log.
+*    Frame boundaries are recorded with their time stamps by calling
+*    frame() before each execution of the pipeline. Starting a
+*    recording writes the current values of all parameters, so a
+*    replay starts from the same state.
+*
+*    Changes within an update of the pipeline are recorded once,
+*    with the value they have when the update ends.
+*
+*    \code{.cpp}
+*
+*        std::ofstream log("session.log", std::ios::binary);
+*        ParameterRecorder recorder(log);
+*        recorder.addParameter("width", pipeline.width);
+*        recorder.start();
+*
+*        // Each frame
+*        recorder.frame();
+*        pipeline.execute();
+*
+*    \endcode
+*
+*    The recorder has to be destroyed before the parameters.
+*
+*  @see ParameterReplayer
+*/
+class GLOPERATE_API ParameterRecorder
+{
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] stream
+    *    Binary output stream, has to outlive the recorder
+    */
+    explicit ParameterRecorder(std::ostream & stream);
+    virtual ~ParameterRecorder();
+
+    /**
+    *  @brief
+    *    Register a parameter, serialized by a property created for its type
+    *
+    *  @param[in] name
+    *    Name of the parameter in the log
+    *  @param[in] data
+    *    Parameter
+    */
+    template <typename T>
+    void addParameter(const std::string & name, Data<T> & data);
+
+    /**
+    *  @brief
+    *    Register a parameter, serialized by an existing property
+    *
+    *  @param[in] name
+    *    Name of the parameter in the log
+    *  @param[in] data
+    *    Parameter whose invalidations are recorded
+    *  @param[in] property
+    *    Property that accesses the value of the parameter
+    */
+    void addParameter(const std::string & name, AbstractData & data, reflectionzeug::AbstractValueProperty & property);
+
+    void start();
+    void stop();
+    bool isRecording() const;
+
+    /**
+    *  @brief
+    *    Record a frame boundary with the time since the start of the recording
+    */
+    void frame();
+
+    size_t frames() const;
+    size_t changes() const;
+
+
+protected:
+    struct Parameter
+    {
+        std::string name;
+        AbstractData * data;
+        reflectionzeug::AbstractValueProperty * property;
+        std::shared_ptr<reflectionzeug::AbstractValueProperty> ownedProperty;
+        signalzeug::Connection connection;
+    };
+
+
+protected:
+    void addParameter(const std::string & name, AbstractData & data, reflectionzeug::AbstractValueProperty * property,
+        const std::shared_ptr<reflectionzeug::AbstractValueProperty> & ownedProperty);
+
+    void declare(size_t index);
+    void recordChange(size_t index);
+
+
+protected:
+    std::ostream & m_stream;
+    std::vector<Parameter> m_parameters;
+
+    bool m_headerWritten;
+    bool m_recording;
+    ChronoTimer m_timer;
+    ChronoTimer::Duration m_lastFrame;  /**< Time stamp of the previous frame boundary */
+
+    size_t m_frames;
+    size_t m_changes;
+};
+
+
+} // namespace gloperate
+
+
+#include <gloperate/pipeline/ParameterRecorder.hpp>
@@ -0,0 +1,25 @@
+#pragma once
+
+
+#include <reflectionzeug/property/Property.h>
+
+#include <gloperate/pipeline/ParameterRecorder.h>
+#include <gloperate/pipeline/Data.h>
+
+
+namespace gloperate
+{
+
+
+template <typename T>
+void ParameterRecorder::addParameter(const std::string & name, Data<T> & data)
+{
+    auto property = std::make_shared<reflectionzeug::Property<T>>(name,
+        [&data]() { return data.data(); },
+        [&data](const T & value) { data.setData(value); });
+
+    addParameter(name, data, property.get(), property);
+}
+
+
+} // namespace gloperate
@@ -0,0 +1,150 @@
+#pragma once
+
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gloperate/base/ChronoTimer.h>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace reflectionzeug
+{
+    class AbstractValueProperty;
+}
+
+
+namespace gloperate
+{
+
+
+class AbstractPipeline;
+
+template <typename T>
+class Data;
+
+
+/**
+*  @brief
+*    Replays a log of parameter changes written by ParameterRecorder
+*
+*    Parameters are matched by the names they have been recorded
+*    with. Each call of nextFrame() assigns the recorded values up to
+*    the next frame boundary, in the order they have been recorded.
+*    Changes of parameters that are not registered are skipped.
+*
+*    Frames are replayed either as fast as possible or with their
+*    original timing, in which case nextFrame() waits until the
+*    recorded time of the frame boundary has passed.
+*
+*    \code{.cpp}
+*
+*        std::ifstream log("session.log", std::ios::binary);
+*        ParameterReplayer replayer(log);
+*        replayer.addParameter("width", pipeline.width);
+*        replayer.replay(pipeline);
+*
+*    \endcode
+*
+*  @see ParameterRecorder
+*/
+class GLOPERATE_API ParameterReplayer
+{
+public:
+    enum class Timing
+    {
+        FullSpeed,
+        Original
+    };
+
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] stream
+    *    Binary input stream, has to outlive the replayer
+    */
+    explicit ParameterReplayer(std::istream & stream);
+    virtual ~ParameterReplayer();
+
+    template <typename T>
+    void addParameter(const std::string & name, Data<T> & data);
+    void addParameter(const std::string & name, reflectionzeug::AbstractValueProperty & property);
+
+    Timing timing() const;
+    void setTiming(Timing timing);
+
+    /**
+    *  @brief
+    *    Check if the log starts with a valid header
+    *
+    *  @return
+    *    'true' if the log can be replayed, else 'false'
+    */
+    bool isValid() const;
+    bool atEnd() const;
+
+    /**
+    *  @brief
+    *    Assign the recorded values up to the next frame boundary
+    *
+    *  @return
+    *    'true' if a frame boundary has been reached, 'false' at the end of the log
+    */
+    bool nextFrame();
+
+    /**
+    *  @brief
+    *    Replay the remaining log, executing the pipeline at each frame boundary
+    *
+    *  @param[in] pipeline
+    *    Pipeline the registered parameters belong to
+    *
+    *  @return
+    *    Number of executed frames
+    */
+    size_t replay(AbstractPipeline & pipeline);
+
+    size_t frames() const;
+    size_t changes() const;
+    size_t skippedChanges() const;
+
+
+protected:
+    void addParameter(const std::string & name, reflectionzeug::AbstractValueProperty * property,
+        const std::shared_ptr<reflectionzeug::AbstractValueProperty> & ownedProperty);
+
+    void applyChange(size_t index, const std::string & value);
+    void waitUntil(ChronoTimer::Duration time);
+
+
+protected:
+    std::istream & m_stream;
+    bool m_valid;
+    bool m_atEnd;
+    Timing m_timing;
+
+    std::unordered_map<std::string, reflectionzeug::AbstractValueProperty *> m_properties;
+    std::vector<std::shared_ptr<reflectionzeug::AbstractValueProperty>> m_ownedProperties;
+    std::vector<std::string> m_names;   /**< Names of the parameter indices of the log */
+
+    bool m_started;
+    ChronoTimer m_timer;
+    ChronoTimer::Duration m_frameTime;  /**< Recorded time stamp of the last frame boundary */
+
+    size_t m_frames;
+    size_t m_changes;
+    size_t m_skippedChanges;
+};
+
+
+} // namespace gloperate
+
+
+#include <gloperate/pipeline/ParameterReplayer.hpp>
@@ -0,0 +1,187 @@
+#pragma once
+
+
+#include <iosfwd>
+#include <unordered_map>
+#include <vector>
+
+#include <gloperate/base/ChronoTimer.h>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+
+class AbstractPipeline;
+class AbstractStage;
+
+
+/**
+*  @brief
+*    Critical-path and parallelism analysis of the stage graph of a pipeline
+*
+*    The graph has an edge from each stage to the stages that require it
+*    directly, i.e., through a non-feedback input or a manual dependency
+*    (see AbstractStage::requires). Each stage is weighted with its
+*    execution time, by default the mean time measured by the profiler
+*    of the pipeline.
+*
+*    The longest weighted path through the graph (critical path) bounds
+*    the frame time for any number of threads, while the sum of all
+*    times (work) is the frame time on a single thread. The speedup for
+*    a number of cores is estimated by list scheduling, where stages
+*    that require the OpenGL context are restricted to the first core.
+*
+*    A stage serializes the graph if no other stage can be processed
+*    concurrently with it, i.e., every other stage is either required
+*    by it or requires it.
+*
+*    \code{.cpp}
+*
+*        pipeline.setProfiling(true);
+*        // ... render some frames ...
+*
+*        PipelineAnalysis analysis(pipeline);
+*        std::cout << analysis.speedup(4) << std::endl;
+*        std::ofstream stream("pipeline.dot");
+*        analysis.writeDot(stream);
+*
+*    \endcode
+*
+*  @see AbstractPipeline::setProfiling
+*/
+class GLOPERATE_API PipelineAnalysis
+{
+public:
+    using Duration = ChronoTimer::Duration;
+
+    struct StageInfo
+    {
+        const AbstractStage * stage;
+        Duration time;
+        Duration earliestStart;     /**< Earliest start with unlimited cores */
+        Duration latestStart;       /**< Latest start that does not extend the critical path */
+        bool serializing;
+        std::vector<size_t> predecessors;   /**< Indices into stages() */
+        std::vector<size_t> successors;     /**< Indices into stages() */
+
+        Duration slack() const;
+        bool isCritical() const;
+    };
+
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] pipeline
+    *    Pipeline, weighted with the mean times recorded by its profiler (zero if profiling is disabled)
+    */
+    explicit PipelineAnalysis(const AbstractPipeline & pipeline);
+
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] pipeline
+    *    Pipeline
+    *  @param[in] times
+    *    Execution time of each stage (missing stages take no time)
+    */
+    PipelineAnalysis(const AbstractPipeline & pipeline, const std::unordered_map<const AbstractStage *, Duration> & times);
+
+    virtual ~PipelineAnalysis();
+
+    /**
+    *  @brief
+    *    Check if the stage graph could be analyzed
+    *
+    *  @return
+    *    'false' if the graph contains a cycle, else 'true'
+    */
+    bool isValid() const;
+
+    /**
+    *  @brief
+    *    Get the stages in topological order
+    */
+    const std::vector<StageInfo> & stages() const;
+
+    Duration work() const;
+    Duration criticalPathLength() const;
+
+    /**
+    *  @brief
+    *    Get the stages of the critical path, in order of execution
+    */
+    std::vector<const AbstractStage *> criticalPath() const;
+
+    /**
+    *  @brief
+    *    Get the stages that cannot be processed concurrently with any other stage
+    */
+    std::vector<const AbstractStage *> serializingStages() const;
+
+    /**
+    *  @brief
+    *    Get the average parallelism of the graph
+    *
+    *  @return
+    *    Work divided by the length of the critical path, i.e., the upper bound of the speedup
+    */
+    double parallelism() const;
+
+    /**
+    *  @brief
+    *    Estimate the frame time on a number of cores
+    *
+    *  @param[in] cores
+    *    Number of cores (at least one)
+    *
+    *  @return
+    *    Makespan of a list schedule that prefers stages with the longest remaining path
+    */
+    Duration scheduleLength(unsigned int cores) const;
+
+    /**
+    *  @brief
+    *    Estimate the speedup on a number of cores
+    *
+    *  @param[in] cores
+    *    Number of cores (at least one)
+    *
+    *  @return
+    *    Work divided by scheduleLength(cores)
+    */
+    double speedup(unsigned int cores) const;
+
+    /**
+    *  @brief
+    *    Write the stage graph with timings in GraphViz DOT format
+    *
+    *    Stages and edges of the critical path are drawn in red,
+    *    serializing stages are filled.
+    *
+    *  @param[in] stream
+    *    Output stream
+    */
+    void writeDot(std::ostream & stream) const;
+
+
+protected:
+    void analyze(const AbstractPipeline & pipeline, const std::unordered_map<const AbstractStage *, Duration> & times);
+    void findSerializingStages();
+
+
+protected:
+    bool m_valid;
+    std::vector<StageInfo> m_stages;
+    Duration m_work;
+    Duration m_criticalPathLength;
+};
+
+
+} // namespace gloperate
@@ -34,6 +34,15 @@ public:
         const cpplocate::ModuleInfo & moduleInfo,
         AbstractPipeline & pipeline);
 
+    /**
+    *  @brief
+    *    Get rendering pipeline
+    *
+    *  @return
+    *    Pipeline executed by the painter
+    */
+    AbstractPipeline & pipeline() const;
+
     virtual void onInitialize() override;
     virtual void onPaint() override;
 
@@ -0,0 +1,51 @@
+#pragma once
+
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+
+class AbstractPipeline;
+
+
+/**
+*  @brief
+*    Scoped update of a pipeline
+*
+*    Starts an update of the pipeline on construction and ends it
+*    on destruction. Invalidations within the scope are delivered
+*    once when the scope is left.
+*
+*    \code{.cpp}
+*
+*        {
+*            PipelineTransaction transaction(pipeline);
+*            camera.setData(newCamera);
+*            viewport.setData(newViewport);
+*        } // Dependent stages are notified once here
+*
+*    \endcode
+*
+*  @see AbstractPipeline::beginUpdate
+*/
+class GLOPERATE_API PipelineTransaction
+{
+public:
+    explicit PipelineTransaction(AbstractPipeline & pipeline);
+    virtual ~PipelineTransaction();
+
+
+protected:
+    AbstractPipeline & m_pipeline;
+
+
+private:
+    PipelineTransaction(const PipelineTransaction &) = delete;
+    PipelineTransaction & operator=(const PipelineTransaction &) = delete;
+};
+
+
+} // namespace gloperate
@@ -0,0 +1,57 @@
+#pragma once
+
+
+#include <cstddef>
+#include <vector>
+
+
+namespace gloperate
+{
+
+
+/**
+*  @brief
+*    Non-owning view of a contiguous range of slots
+*
+*    Views refer to the slot arrays of a stage and stay valid
+*    until slots are added to that stage.
+*
+*  @see AbstractStage::inputs
+*  @see AbstractStage::outputs
+*/
+template <typename T>
+class SlotView
+{
+public:
+    using value_type = T;
+    using const_iterator = const T *;
+    using iterator = const_iterator;
+
+
+public:
+    SlotView();
+    SlotView(const std::vector<T> & slots, size_t count);
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    size_t size() const;
+    bool empty() const;
+
+    const T & operator[](size_t index) const;
+
+    bool contains(const T & slot) const;
+
+    std::vector<T> toVector() const;
+
+
+protected:
+    const T * m_begin;
+    const T * m_end;
+};
+
+
+} // namespace gloperate
+
+
+#include <gloperate/pipeline/SlotView.hpp>
@@ -0,0 +1,70 @@
+#pragma once
+
+
+#include <algorithm>
+
+#include <gloperate/pipeline/SlotView.h>
+
+
+namespace gloperate
+{
+
+
+template <typename T>
+SlotView<T>::SlotView()
+: m_begin(nullptr)
+, m_end(nullptr)
+{
+}
+
+template <typename T>
+SlotView<T>::SlotView(const std::vector<T> & slots, size_t count)
+: m_begin(slots.data())
+, m_end(slots.data() + count)
+{
+}
+
+template <typename T>
+typename SlotView<T>::const_iterator SlotView<T>::begin() const
+{
+    return m_begin;
+}
+
+template <typename T>
+typename SlotView<T>::const_iterator SlotView<T>::end() const
+{
+    return m_end;
+}
+
+template <typename T>
+size_t SlotView<T>::size() const
+{
+    return static_cast<size_t>(m_end - m_begin);
+}
+
+template <typename T>
+bool SlotView<T>::empty() const
+{
+    return m_begin == m_end;
+}
+
+template <typename T>
+const T & SlotView<T>::operator[](size_t index) const
+{
+    return m_begin[index];
+}
+
+template <typename T>
+bool SlotView<T>::contains(const T & slot) const
+{
+    return std::find(m_begin, m_end, slot) != m_end;
+}
+
+template <typename T>
+std::vector<T> SlotView<T>::toVector() const
+{
+    return std::vector<T>(m_begin, m_end);
+}
+
+
+} // namespace gloperate
@@ -0,0 +1,103 @@
+#pragma once
+
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <gloperate/pipeline/SlotView.h>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+
+class AbstractData;
+
+
+/**
+*  @brief
+*    Least recently used cache of stage outputs
+*
+*    Stores snapshots of the outputs of a stage, keyed by the
+*    content hashes of its inputs. On a hit, the snapshots are
+*    restored into the outputs, so processing can be skipped.
+*
+*  @see AbstractStage::setMemoization
+*/
+class GLOPERATE_API StageCache
+{
+public:
+    using Key = std::vector<size_t>;
+
+
+public:
+    explicit StageCache(size_t capacity = 8);
+    virtual ~StageCache();
+
+    size_t capacity() const;
+    void setCapacity(size_t capacity);
+
+    size_t size() const;
+    size_t sizeInBytes() const;
+
+    size_t hits() const;
+    size_t misses() const;
+
+    /**
+    *  @brief
+    *    Restore the outputs stored for a key
+    *
+    *  @param[in] key
+    *    Content hashes of the inputs
+    *  @param[in] outputs
+    *    Outputs of the stage, in the order they have been stored
+    *
+    *  @return
+    *    'true' if an entry has been found and restored, else 'false'
+    */
+    bool restore(const Key & key, SlotView<AbstractData *> outputs);
+
+    /**
+    *  @brief
+    *    Store snapshots of the outputs for a key
+    *
+    *  @param[in] key
+    *    Content hashes of the inputs
+    *  @param[in] outputs
+    *    Outputs of the stage
+    *
+    *  @return
+    *    'true' if stored, 'false' if an output cannot be copied
+    */
+    bool store(const Key & key, SlotView<AbstractData *> outputs);
+
+    void clear();
+
+
+protected:
+    struct Entry
+    {
+        Key key;
+        std::vector<std::shared_ptr<AbstractData>> snapshots;
+    };
+
+
+protected:
+    static size_t combinedHash(const Key & key);
+
+
+protected:
+    size_t m_capacity;
+    size_t m_hits;
+    size_t m_misses;
+
+    std::list<Entry> m_entries; /**< Most recently used entry first */
+    std::unordered_map<size_t, std::list<Entry>::iterator> m_index;
+};
+
+
+} // namespace gloperate
@@ -0,0 +1,148 @@
+#pragma once
+
+
+#include <deque>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <gloperate/base/ChronoTimer.h>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+
+class AbstractStage;
+
+
+/**
+*  @brief
+*    Records the execution of the stages of a pipeline
+*
+*    For each stage, the profiler accumulates the number of
+*    invocations, the number of frames in which the stage has not
+*    been processed (stage disabled, not dirty, or inputs not usable),
+*    and the time spent in process().
+*    Additionally, the individual executions of the most recent frames
+*    are kept and can be exported in the Chrome trace event format
+*    (load the file in chrome://tracing).
+*
+*    Recording is thread-safe, so stages that are executed in
+*    parallel can report to the same profiler.
+*
+*  @see AbstractPipeline::setProfiling
+*/
+class GLOPERATE_API StageProfiler
+{
+public:
+    using Duration = ChronoTimer::Duration;
+
+    struct Statistics
+    {
+        std::string stageName;
+        size_t invocations;
+        size_t skips;
+        Duration totalTime;
+        Duration minTime;
+        Duration maxTime;
+    };
+
+    struct Event
+    {
+        size_t stageIndex;  /**< Index into statistics() */
+        Duration start;     /**< Relative to the creation of the profiler */
+        Duration duration;
+        std::thread::id thread;
+    };
+
+    struct Frame
+    {
+        Duration start;
+        Duration duration;
+        std::thread::id thread;
+        std::vector<Event> events;
+    };
+
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] historySize
+    *    Number of frames whose individual stage executions are kept
+    */
+    explicit StageProfiler(size_t historySize = 120);
+    virtual ~StageProfiler();
+
+    size_t historySize() const;
+    void setHistorySize(size_t historySize);
+
+    Duration timestamp() const;
+
+    void beginFrame();
+    void endFrame(const std::vector<AbstractStage *> & stages);
+
+    void recordExecution(const AbstractStage * stage, Duration start, Duration duration);
+
+    std::vector<Statistics> statistics() const;
+
+    /**
+    *  @brief
+    *    Get the mean time of the recorded executions of a stage
+    *
+    *  @param[in] stage
+    *    Stage
+    *
+    *  @return
+    *    Mean time spent in process(), zero if the stage has not been executed
+    */
+    Duration meanTime(const AbstractStage * stage) const;
+    std::deque<Frame> frames() const;
+
+    void reset();
+
+    /**
+    *  @brief
+    *    Write the recorded frames as Chrome trace event JSON
+    *
+    *  @param[in] stream
+    *    Output stream
+    */
+    void writeTrace(std::ostream & stream) const;
+
+    /**
+    *  @brief
+    *    Write a table of the accumulated statistics of all stages, most expensive stage first
+    *
+    *  @param[in] stream
+    *    Output stream
+    */
+    void writeSummary(std::ostream & stream) const;
+
+
+protected:
+    Statistics & stageStatistics(const AbstractStage * stage);
+
+
+protected:
+    mutable std::mutex m_mutex;
+    ChronoTimer m_timer;    /**< Time base of all events */
+    size_t m_historySize;
+    size_t m_frameDepth;    /**< Number of nested beginFrame() calls */
+    size_t m_frameCount;
+
+    std::unordered_map<const AbstractStage *, size_t> m_stageIndices;
+    std::vector<Statistics> m_statistics;
+    std::vector<size_t> m_lastFrames;   /**< Number of the frame each stage has last been processed in */
+    std::deque<Frame> m_frames;
+};
+
+
+} // namespace gloperate
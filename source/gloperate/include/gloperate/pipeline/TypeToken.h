@@ -0,0 +1,61 @@
+#pragma once
+
+
+#include <cstddef>
+#include <string>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+
+/**
+*  @brief
+*    Identifier of the type of a data container or input slot
+*
+*    The id is a hash of the readable name of the type, which is
+*    taken from the signature of a function of this template. It
+*    therefore does not depend on RTTI and is the same in every
+*    module built with the same compiler, including plugins.
+*
+*    Data containers and input slots store the id of their type on
+*    construction, so matching them is an integer comparison.
+*
+*  @see AbstractData::typeId
+*  @see AbstractInputSlot::typeId
+*/
+template <typename T>
+class TypeToken
+{
+public:
+    static size_t id();
+    static std::string name();
+
+
+protected:
+    static const char * signature();
+};
+
+
+/**
+*  @brief
+*    Get the id of a type by its readable name
+*
+*  @param[in] typeName
+*    Name as returned by TypeToken<T>::name()
+*
+*  @return
+*    Id as returned by TypeToken<T>::id()
+*/
+GLOPERATE_API size_t typeIdFromName(const std::string & typeName);
+
+GLOPERATE_API size_t typeIdFromSignature(const char * signature);
+GLOPERATE_API std::string typeNameFromSignature(const char * signature);
+
+
+} // namespace gloperate
+
+
+#include <gloperate/pipeline/TypeToken.hpp>
@@ -0,0 +1,37 @@
+#pragma once
+
+
+#include <gloperate/pipeline/TypeToken.h>
+
+
+namespace gloperate
+{
+
+
+template <typename T>
+size_t TypeToken<T>::id()
+{
+    // Hashing the signature is only done once per type
+    static const size_t id = typeIdFromSignature(signature());
+
+    return id;
+}
+
+template <typename T>
+std::string TypeToken<T>::name()
+{
+    return typeNameFromSignature(signature());
+}
+
+template <typename T>
+const char * TypeToken<T>::signature()
+{
+#ifdef _MSC_VER
+    return __FUNCSIG__;
+#else
+    return __PRETTY_FUNCTION__;
+#endif
+}
+
+
+} // namespace gloperate
@@ -24,6 +24,18 @@ namespace gloperate
 */
 class GLOPERATE_API AbstractLoader 
 {
+public:
+    /**
+    *  @brief
+    *    Data read by Loader::prepare() that is turned into the resource by Loader::finish()
+    */
+    class GLOPERATE_API Prepared
+    {
+    public:
+        virtual ~Prepared();
+    };
+
+
 public:
     /**
     *  @brief
@@ -42,7 +54,7 @@ public:
     *    Check if this loader can load a specific file type
     *
     *  @param[in] ext
-    *    File extension (e.g., '.png')
+    *    File extension in lower-case (e.g., 'png')
     *
     *  @return
     *    'true' if loading is implemented for given file type, else 'false'
@@ -72,6 +84,46 @@ public:
     *    Example string: "*.mft *.any *.txt"
     */
     virtual std::string allLoadingTypes() const = 0;
+
+    /**
+    *  @brief
+    *    Get the type of the loaded resources
+    *
+    *  @return
+    *    Type id of the resource type (see TypeToken)
+    */
+    virtual size_t resourceTypeId() const = 0;
+
+    /**
+    *  @brief
+    *    Check if this loader recognizes the content of a file
+    *
+    *  @param[in] header
+    *    First bytes of the file
+    *  @param[in] size
+    *    Number of bytes (can be less than the header of the file type)
+    *
+    *  @return
+    *    'true' if the content has the signature of a supported file type, else 'false' (default: 'false')
+    *
+    *  @remarks
+    *    Used by ResourceManager if several loaders support the extension of a file, or none does.
+    */
+    virtual bool canLoadContent(const char * header, size_t size) const;
+
+    /**
+    *  @brief
+    *    Check if loading needs the OpenGL context
+    *
+    *  @return
+    *    'true' if only the thread owning the OpenGL context may call Loader::finish(), else 'false' (default: 'true')
+    *
+    *  @remarks
+    *    Loaders that do not need the context are executed completely on a loading thread by
+    *    ResourceManager::loadAsync(). Loaders that need it can still move reading and decoding
+    *    to a loading thread by implementing Loader::prepare() and Loader::finish().
+    */
+    virtual bool requiresContext() const;
 };
 
 
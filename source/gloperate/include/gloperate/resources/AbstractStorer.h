@@ -42,7 +42,7 @@ public:
     *    Check if this storer can store a specific file type
     *
     *  @param[in] ext
-    *    File extension (e.g., '.png')
+    *    File extension in lower-case (e.g., 'png')
     *
     *  @return
     *    'true' if storing is implemented for given file type, else 'false'
@@ -72,6 +72,15 @@ public:
     *    Example string: "*.mft *.any *.txt"
     */
     virtual std::string allStoringTypes() const = 0;
+
+    /**
+    *  @brief
+    *    Get the type of the stored resources
+    *
+    *  @return
+    *    Type id of the resource type (see TypeToken)
+    */
+    virtual size_t resourceTypeId() const = 0;
 };
 
 
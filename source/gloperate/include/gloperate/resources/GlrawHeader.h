@@ -0,0 +1,170 @@
+
+#pragma once
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+
+class RawFile;
+
+
+/**
+*  @brief
+*    Header and data layout of a glraw texture file
+*
+*    A glraw file starts with a magic number and the offset of the
+*    texture data, followed by typed properties. Integer properties
+*    describe the texture, all others are skipped. The data holds one
+*    or more mipmap levels one after another, starting with the largest.
+*
+*    Data is laid out in rows, which are single rows of pixels for
+*    uncompressed and rows of 4x4 blocks for compressed textures.
+*/
+class GLOPERATE_API GlrawHeader
+{
+public:
+    /**
+    *  @brief
+    *    Memory layout of one mipmap level
+    */
+    struct Level
+    {
+        int width;
+        int height;
+        int rowHeight;      /**< Height of a row in pixels */
+        size_t rows;
+        size_t rowSize;     /**< Size of a row in bytes */
+    };
+
+
+public:
+    /**
+    *  @brief
+    *    Check if data starts with the glraw magic number
+    *
+    *  @param[in] data
+    *    Start of the file
+    *  @param[in] size
+    *    Number of bytes available at data
+    *
+    *  @return
+    *    'true' if the data can be a glraw file, else 'false'
+    */
+    static bool hasMagicNumber(const char * data, size_t size);
+
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    */
+    GlrawHeader();
+
+    /**
+    *  @brief
+    *    Read the header of a file
+    *
+    *  @param[in] file
+    *    glraw file (can be opened in any mode)
+    *
+    *  @return
+    *    'true' if the header was read, 'false' if it is truncated or malformed
+    *
+    *  @remarks
+    *    The level layout is computed from the properties, see levels().
+    */
+    bool read(const RawFile & file);
+
+    /**
+    *  @brief
+    *    Get an integer property
+    *
+    *  @param[in] key
+    *    Name of the property
+    *  @param[in] defaultValue
+    *    Value returned if the header does not contain the property
+    *
+    *  @return
+    *    Value of the property
+    */
+    int property(const std::string & key, int defaultValue = 0) const;
+
+    /**
+    *  @brief
+    *    Get integer properties
+    *
+    *  @return
+    *    Integer properties by name
+    */
+    const std::map<std::string, int> & properties() const;
+
+    /**
+    *  @brief
+    *    Check if the texture is compressed
+    *
+    *  @return
+    *    'true' if the header provides a compressed format, else 'false'
+    */
+    bool isCompressed() const;
+
+    /**
+    *  @brief
+    *    Get the offset of the texture data
+    *
+    *  @return
+    *    Start of the texture data in the file
+    */
+    size_t dataOffset() const;
+
+    /**
+    *  @brief
+    *    Get the layout of all mipmap levels
+    *
+    *  @return
+    *    Layout of each level, empty if the properties do not describe a valid texture
+    */
+    const std::vector<Level> & levels() const;
+
+    /**
+    *  @brief
+    *    Get the size of the texture data
+    *
+    *  @return
+    *    Size of all levels in bytes
+    */
+    size_t dataSize() const;
+
+    /**
+    *  @brief
+    *    Check if a file contains the whole texture
+    *
+    *  @param[in] fileSize
+    *    Size of the file in bytes
+    *
+    *  @return
+    *    'true' if the texture is valid and all levels fit into the file, else 'false'
+    */
+    bool isComplete(size_t fileSize) const;
+
+
+protected:
+    void computeLevels();
+
+
+protected:
+    std::map<std::string, int> m_properties;  /**< Integer properties of the header */
+    size_t                     m_dataOffset;  /**< Start of the texture data in the file */
+    std::vector<Level>         m_levels;
+    size_t                     m_dataSize;
+};
+
+
+} // namespace gloperate
@@ -15,6 +15,18 @@ namespace gloperate
 *  @brief
 *    Loader for glraw textures
 *
+*    A glraw file starts with a header of properties that describe the
+*    texture, followed by its raw data (see GlrawHeader). Uncompressed
+*    textures provide 'width', 'height', 'format' and 'type', compressed
+*    textures provide 'width', 'height', 'compressedFormat' and 'size'.
+*    If 'levels' is present, the data contains this number of mipmap
+*    levels one after another, starting with the largest.
+*
+*    The file is mapped into memory and its pages are read on the
+*    loading thread. It is uploaded in chunks through a pixel unpack
+*    buffer, so neither a copy of the whole texture is kept in memory
+*    nor a single large upload stalls the context thread.
+*
 *  Supported options:
 *    none
 */
@@ -37,9 +49,12 @@ public:
     virtual bool canLoad(const std::string & ext) const override;
     virtual std::vector<std::string> loadingTypes() const override;
     virtual std::string allLoadingTypes() const override;
+    virtual bool canLoadContent(const char * header, size_t size) const override;
 
     // Virtual gloperate::Loader<globjects::Texture> functions
     virtual globjects::Texture * load(const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> progress) const override;
+    virtual std::unique_ptr<Prepared> prepare(const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> progress) const override;
+    virtual globjects::Texture * finish(const std::string & filename, const reflectionzeug::Variant & options, std::unique_ptr<Prepared> prepared, std::function<void(int, int)> progress) const override;
 };
 
 
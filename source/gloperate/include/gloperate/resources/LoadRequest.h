@@ -0,0 +1,259 @@
+#pragma once
+
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <reflectionzeug/variant/Variant.h>
+
+#include <gloperate/resources/AbstractLoader.h>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+
+template <typename T>
+class Loader;
+
+
+/**
+*  @brief
+*    State of an asynchronous load started by ResourceManager::loadAsync()
+*
+*    Reading and decoding run on a loading thread. Loaders that need
+*    the OpenGL context create the resource later on the context
+*    thread, in ResourceManager::processUploads(). An exception thrown
+*    by the loader finishes the request and is passed on to the caller
+*    of LoadRequest::get(), as for ResourceManager::load().
+*
+*  @see LoadRequest
+*/
+class GLOPERATE_API AbstractLoadRequest
+{
+    friend class ResourceManager;
+
+
+public:
+    enum class Status : int
+    {
+        Queued,     /**< Waiting for a loading thread */
+        Loading,    /**< Reading on a loading thread */
+        Uploading,  /**< Waiting for or being created on the context thread */
+        Finished,   /**< Resource is available (can be null if loading failed, or the loader threw) */
+        Canceled    /**< Canceled before the resource was created */
+    };
+
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] filename
+    *    File name
+    *  @param[in] progress
+    *    Callback function that is invoked on progress from the loading thread (can be empty)
+    */
+    AbstractLoadRequest(const std::string & filename, std::function<void(int, int)> progress);
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    virtual ~AbstractLoadRequest();
+
+    // Fixes issues with MSVC2013 Update 3
+    AbstractLoadRequest(const AbstractLoadRequest & rhs) = delete;
+    AbstractLoadRequest & operator=(const AbstractLoadRequest & rhs) = delete;
+
+    const std::string & filename() const;
+
+    Status status() const;
+
+    /**
+    *  @brief
+    *    Check if the request is finished or canceled
+    */
+    bool isDone() const;
+
+    /**
+    *  @brief
+    *    Get the progress reported by the loader
+    *
+    *  @return
+    *    Fraction of the work done in [0, 1]
+    */
+    float progress() const;
+
+    /**
+    *  @brief
+    *    Cancel the request
+    *
+    *  @return
+    *    'true' if no resource will be created, 'false' if it is created or already available
+    *
+    *  @remarks
+    *    A loader that does not need the context cannot be interrupted,
+    *    its resource is still delivered if it is already loading.
+    */
+    bool cancel();
+
+
+protected:
+    /**
+    *  @brief
+    *    Execute the part of loading that does not need the context (called on a loading thread)
+    *
+    *  @return
+    *    'true' if the resource has to be created on the context thread (see markUploading()), else 'false'
+    */
+    bool load();
+
+    /**
+    *  @brief
+    *    Wait for the context thread after load() returned 'true'
+    *
+    *  @return
+    *    'true' if the resource is to be uploaded, 'false' if the request has been canceled meanwhile
+    *
+    *  @remarks
+    *    The caller queues the request for upload() together with this call,
+    *    so that a request reported as uploading is already queued.
+    */
+    bool markUploading();
+
+    /**
+    *  @brief
+    *    Create the resource (called on the context thread)
+    */
+    void upload();
+
+    void reportProgress(int current, int total);
+
+    virtual bool requiresContext() const = 0;
+    virtual void loadResource() = 0;
+    virtual void prepareResource() = 0;
+    virtual void finishResource() = 0;
+    virtual void discardResource() = 0;
+    virtual void publishResource() = 0;
+
+    void fail(std::exception_ptr exception);
+
+
+protected:
+    std::string m_filename;
+    std::function<void(int, int)> m_progressCallback;
+
+    mutable std::mutex m_mutex;
+    Status m_status;
+    bool m_cancelRequested; /**< Cancel was requested while loading */
+    bool m_uploadStarted;
+    std::exception_ptr m_exception;  /**< Exception thrown by the loader (null if none) */
+
+    std::atomic<int> m_progressCurrent;
+    std::atomic<int> m_progressTotal;
+};
+
+
+/**
+*  @brief
+*    Handle to an asynchronously loaded resource
+*
+*    \code{.cpp}
+*
+*        auto request = resourceManager.loadAsync<Scene>("data/scene.obj");
+*
+*        // Once per frame, on the context thread
+*        resourceManager.processUploads();
+*
+*        if (request->isDone())
+*            scene = request->get();
+*
+*    \endcode
+*
+*    The resource is owned by the caller, just as for ResourceManager::load().
+*
+*  @remarks
+*    Waiting for a resource on the context thread blocks forever if the
+*    loader needs the context, unless processUploads() is called meanwhile.
+*/
+template <typename T>
+class LoadRequest : public AbstractLoadRequest
+{
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] loader
+    *    Loader (must outlive the request)
+    *  @param[in] filename
+    *    File name
+    *  @param[in] options
+    *    Options for loading resource, see documentation of specific loader for supported options
+    *  @param[in] progress
+    *    Callback function that is invoked on progress from the loading thread (can be empty)
+    */
+    LoadRequest(const Loader<T> & loader, const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> progress);
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    virtual ~LoadRequest();
+
+    /**
+    *  @brief
+    *    Get future of the resource
+    *
+    *  @return
+    *    Future that is set when the request is done (to null if loading failed or was canceled,
+    *    to the exception if the loader threw one)
+    */
+    std::shared_future<T *> future() const;
+
+    /**
+    *  @brief
+    *    Wait for the request and get the resource
+    *
+    *  @return
+    *    Loaded resource (can be null)
+    *
+    *  @remarks
+    *    Rethrows the exception if the loader threw one.
+    */
+    T * get() const;
+
+
+protected:
+    virtual bool requiresContext() const override;
+    virtual void loadResource() override;
+    virtual void prepareResource() override;
+    virtual void finishResource() override;
+    virtual void discardResource() override;
+    virtual void publishResource() override;
+
+
+protected:
+    const Loader<T> & m_loader;
+    reflectionzeug::Variant m_options;
+    std::unique_ptr<AbstractLoader::Prepared> m_prepared;
+    T * m_resource;
+
+    std::promise<T *> m_promise;
+    std::shared_future<T *> m_future;
+};
+
+
+} // namespace gloperate
+
+
+#include <gloperate/resources/LoadRequest.hpp>
@@ -0,0 +1,81 @@
+#pragma once
+
+
+#include <gloperate/resources/LoadRequest.h>
+
+#include <gloperate/resources/Loader.h>
+
+
+namespace gloperate
+{
+
+
+template <typename T>
+LoadRequest<T>::LoadRequest(const Loader<T> & loader, const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> progress)
+: AbstractLoadRequest(filename, progress)
+, m_loader(loader)
+, m_options(options)
+, m_resource(nullptr)
+, m_future(m_promise.get_future().share())
+{
+}
+
+template <typename T>
+LoadRequest<T>::~LoadRequest()
+{
+}
+
+template <typename T>
+std::shared_future<T *> LoadRequest<T>::future() const
+{
+    return m_future;
+}
+
+template <typename T>
+T * LoadRequest<T>::get() const
+{
+    return m_future.get();
+}
+
+template <typename T>
+bool LoadRequest<T>::requiresContext() const
+{
+    return m_loader.requiresContext();
+}
+
+template <typename T>
+void LoadRequest<T>::loadResource()
+{
+    m_resource = m_loader.load(m_filename, m_options, [this](int current, int total) { reportProgress(current, total); });
+}
+
+template <typename T>
+void LoadRequest<T>::prepareResource()
+{
+    m_prepared = m_loader.prepare(m_filename, m_options, [this](int current, int total) { reportProgress(current, total); });
+}
+
+template <typename T>
+void LoadRequest<T>::finishResource()
+{
+    m_resource = m_loader.finish(m_filename, m_options, std::move(m_prepared), [this](int current, int total) { reportProgress(current, total); });
+}
+
+template <typename T>
+void LoadRequest<T>::discardResource()
+{
+    m_prepared.reset();
+    m_resource = nullptr;
+}
+
+template <typename T>
+void LoadRequest<T>::publishResource()
+{
+    if (m_exception)
+        m_promise.set_exception(m_exception);
+    else
+        m_promise.set_value(m_resource);
+}
+
+
+} // namespace gloperate
@@ -3,6 +3,7 @@
 
 
 #include <functional>
+#include <memory>
 
 #include <gloperate/resources/AbstractLoader.h>
 
@@ -36,6 +37,9 @@ public:
     */
     virtual ~Loader();
 
+    // Virtual gloperate::AbstractLoader functions
+    virtual size_t resourceTypeId() const override;
+
     /**
     *  @brief
     *    Load resource from file
@@ -51,6 +55,47 @@ public:
     *    Loaded resource (can be null)
     */
     virtual T * load(const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> progress) const = 0;
+
+    /**
+    *  @brief
+    *    Read and decode a resource file without using the OpenGL context
+    *
+    *  @param[in] filename
+    *    File name
+    *  @param[in] options
+    *    Options for loading resource, see documentation of specific loader for supported options
+    *  @param[in] progress
+    *    Callback function that is invoked on progress (can be empty)
+    *
+    *  @return
+    *    Data passed to finish() (can be null)
+    *
+    *  @remarks
+    *    Called on a loading thread by ResourceManager::loadAsync() if the loader requires the context.
+    *    The default implementation does nothing, so finish() calls load() on the context thread.
+    */
+    virtual std::unique_ptr<Prepared> prepare(const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> progress) const;
+
+    /**
+    *  @brief
+    *    Create the resource from prepared data
+    *
+    *  @param[in] filename
+    *    File name
+    *  @param[in] options
+    *    Options for loading resource, see documentation of specific loader for supported options
+    *  @param[in] prepared
+    *    Data returned by prepare() (can be null)
+    *  @param[in] progress
+    *    Callback function that is invoked on progress (can be empty)
+    *
+    *  @return
+    *    Loaded resource (can be null)
+    *
+    *  @remarks
+    *    Called on the thread owning the OpenGL context. The default implementation calls load().
+    */
+    virtual T * finish(const std::string & filename, const reflectionzeug::Variant & options, std::unique_ptr<Prepared> prepared, std::function<void(int, int)> progress) const;
 };
 
 
@@ -4,6 +4,8 @@
 
 #include <gloperate/resources/Loader.h>
 
+#include <gloperate/pipeline/TypeToken.h>
+
 
 namespace gloperate
 {
@@ -19,5 +21,23 @@ Loader<T>::~Loader()
 {
 }
 
+template <typename T>
+size_t Loader<T>::resourceTypeId() const
+{
+    return TypeToken<T>::id();
+}
+
+template <typename T>
+std::unique_ptr<AbstractLoader::Prepared> Loader<T>::prepare(const std::string & /*filename*/, const reflectionzeug::Variant & /*options*/, std::function<void(int, int)> /*progress*/) const
+{
+    return nullptr;
+}
+
+template <typename T>
+T * Loader<T>::finish(const std::string & filename, const reflectionzeug::Variant & options, std::unique_ptr<Prepared> /*prepared*/, std::function<void(int, int)> progress) const
+{
+    return load(filename, options, progress);
+}
+
 
 } // namespace gloperate
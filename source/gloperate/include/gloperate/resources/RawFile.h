@@ -1,4 +1,3 @@
-
 #pragma once
 
 
@@ -22,29 +21,94 @@ namespace gloperate
 *    how to interpret the content of the file, e.g., you need to know the format and size of the
 *    texture, the file does not provide this information. To create raw textures, you can use
 *    for example glraw.
+*
+*    By default, the file is mapped into memory instead of being copied, so its pages are only
+*    read when they are accessed and can be dropped again by the operating system. If mapping
+*    is not possible, the file is read into memory instead. Files that are larger than the
+*    available memory can be opened for streaming and read in ranges.
+*
+*    \code{.cpp}
+*
+*        RawFile volume("volume.512.512.512.r.us.raw", RawFile::Mode::Stream);
+*        std::vector<char> slice(512 * 512 * 2);
+*
+*        for (size_t z = 0; z < 512; ++z)
+*            volume.read(z * slice.size(), slice.size(), slice.data());
+*
+*    \endcode
 */
 class GLOPERATE_API RawFile
 {
 public:
-    RawFile(const std::string & filePath);
+    enum class Mode : unsigned int
+    {
+        Map,    /**< Map the file into memory, falls back to Read */
+        Read,   /**< Copy the file into memory */
+        Stream  /**< Keep the file on disk, data() is null and only read() can be used */
+    };
+
+
+public:
+    RawFile(const std::string & filePath, Mode mode = Mode::Map);
+    RawFile(RawFile && other);
     virtual ~RawFile();
 
+    // Mapped memory is owned by exactly one instance
+    RawFile(const RawFile & rhs) = delete;
+    RawFile & operator=(const RawFile & rhs) = delete;
+
     const char * data() const;
     size_t size() const;
 
     bool isValid() const;
     const std::string & filePath() const;
 
+    /**
+    *  @brief
+    *    Get the mode used to access the file
+    *
+    *  @return
+    *    Access mode (Read if mapping was requested but failed)
+    */
+    Mode mode() const;
+
+    /**
+    *  @brief
+    *    Read a range of the file
+    *
+    *  @param[in] offset
+    *    Offset of the range in bytes
+    *  @param[in] size
+    *    Size of the range in bytes
+    *  @param[out] destination
+    *    Memory of at least size bytes
+    *
+    *  @return
+    *    Number of bytes read, less than size if the range exceeds the file
+    *
+    *  @remarks
+    *    Can be used in every mode and from several threads at once.
+    */
+    size_t read(std::uint64_t offset, size_t size, char * destination) const;
+
 
 protected:
     bool readFile();
     void readRawData(std::ifstream & ifs);
+    bool mapFile();
+    bool queryFileSize();
+    void unmapFile();
 
 
 protected:
     const std::string m_filePath;
+    Mode              m_mode;
     std::vector<char> m_data;
     bool              m_valid;
+
+    const char *      m_mappedData;  /**< Start of the mapping (nullptr if not mapped) */
+    size_t            m_size;
+    void *            m_fileHandle;  /**< File mapping object (Windows only) */
 };
 
 
@@ -0,0 +1,171 @@
+#pragma once
+
+
+#include <condition_variable>
+#include <functional>
+#include <iosfwd>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <globjects/base/ref_ptr.h>
+#include <globjects/base/Referenced.h>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+
+/**
+*  @brief
+*    Cache of shared resources with least-recently-used eviction
+*
+*    Resources are identified by a key, which ResourceManager builds
+*    from the resource type, the canonical path and modification time
+*    of the file, and the loading options. The cache keeps a reference
+*    to each resource, so requesting the same key again returns the
+*    same object instead of loading the file again.
+*
+*    If several threads request a key that is being loaded, only the
+*    first one loads it, the others wait for its result. Failed loads,
+*    including loads that throw, are not cached.
+*
+*    When the resources exceed the byte budget, the least recently
+*    used ones are released. Resources that are still referenced
+*    elsewhere are kept, as releasing them would not free any memory.
+*    The budget is enforced when a resource is added, when the budget
+*    is changed and by trim(), which ResourceManager calls from
+*    processUploads() to release resources that are no longer in use.
+*    Releasing OpenGL objects needs the context, so caches holding them
+*    have to be used on the thread owning it.
+*
+*  @see ResourceManager::get
+*/
+class GLOPERATE_API ResourceCache
+{
+public:
+    using Resource = globjects::ref_ptr<globjects::Referenced>;
+
+    /**
+    *  @brief
+    *    Function that loads a resource, returning it and its size in bytes
+    */
+    using LoadFunction = std::function<std::pair<globjects::Referenced *, size_t>()>;
+
+    struct Statistics
+    {
+        size_t hits;
+        size_t misses;
+        size_t evictions;
+        size_t entries;
+        size_t bytes;
+        size_t peakBytes;
+    };
+
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] budget
+    *    Size in bytes up to which unused resources are kept
+    */
+    explicit ResourceCache(size_t budget = 256 * 1024 * 1024);
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    virtual ~ResourceCache();
+
+    size_t budget() const;
+    void setBudget(size_t budget);
+
+    Statistics statistics() const;
+
+    /**
+    *  @brief
+    *    Get a cached resource or load it
+    *
+    *  @param[in] key
+    *    Key of the resource
+    *  @param[in] load
+    *    Function that loads the resource if it is not cached (called without holding the lock)
+    *
+    *  @return
+    *    Resource (can be null if loading failed)
+    */
+    Resource get(const std::string & key, const LoadFunction & load);
+
+    /**
+    *  @brief
+    *    Check if a resource is cached
+    *
+    *  @param[in] key
+    *    Key of the resource
+    *
+    *  @return
+    *    'true' if the resource is loaded and cached, else 'false'
+    */
+    bool contains(const std::string & key) const;
+
+    /**
+    *  @brief
+    *    Release least recently used resources that are not in use until the budget is met
+    */
+    void trim();
+
+    /**
+    *  @brief
+    *    Release all resources that are not being loaded and reset the statistics
+    */
+    void clear();
+
+    /**
+    *  @brief
+    *    Write the statistics of the cache
+    *
+    *  @param[in] stream
+    *    Output stream
+    */
+    void writeSummary(std::ostream & stream) const;
+
+
+protected:
+    struct Entry
+    {
+        std::string key;
+        Resource resource;
+        size_t bytes;
+        bool loading;   /**< Resource is being loaded by another thread */
+    };
+
+    using EntryList = std::list<Entry>;
+
+
+protected:
+    void evict();
+
+
+protected:
+    mutable std::mutex m_mutex;
+    std::condition_variable m_loaded;   /**< Notified whenever a load has ended */
+
+    size_t m_budget;
+    EntryList m_entries;                /**< Most recently used first */
+    std::unordered_map<std::string, EntryList::iterator> m_index;
+
+    size_t m_bytes;
+    size_t m_peakBytes;
+    size_t m_hits;
+    size_t m_misses;
+    size_t m_evictions;
+};
+
+
+} // namespace gloperate
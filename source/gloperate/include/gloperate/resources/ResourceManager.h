@@ -4,10 +4,18 @@
 
 #include <string>
 #include <vector>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 
 #include <reflectionzeug/variant/Variant.h>
 
+#include <gloperate/base/ChronoTimer.h>
+#include <gloperate/resources/ResourceCache.h>
+
 #include <gloperate/gloperate_api.h>
 
 
@@ -22,12 +30,34 @@ namespace gloperate
 
 
 class AbstractLoader;
+class AbstractLoadRequest;
 class AbstractStorer;
+class ThreadPool;
+
+template <typename T>
+class Loader;
+
+template <typename T>
+class LoadRequest;
 
 
 /**
 *  @brief
 *    Class to help loading/accessing resources (textures, ...)
+*
+*    Resources can be loaded asynchronously by loadAsync(). Reading and
+*    decoding files then runs on a pool of loading threads, while the
+*    creation of OpenGL objects is deferred to processUploads(), which
+*    has to be called regularly on the thread owning the OpenGL context.
+*
+*    Resources requested by get() are shared through a ResourceCache,
+*    so a file is loaded only once for all painters and stages using it.
+*
+*    Loaders and storers are indexed by resource type and the extensions
+*    they list in allLoadingTypes() and allStoringTypes(), so finding one
+*    for a file is a single lookup. If several loaders support the
+*    extension of a file, or none does, the first bytes of the file are
+*    passed to AbstractLoader::canLoadContent() to choose one.
 */
 class GLOPERATE_API ResourceManager
 {
@@ -35,8 +65,14 @@ public:
     /**
     *  @brief
     *    Constructor
+    *
+    *  @param[in] numLoadingThreads
+    *    Number of threads for asynchronous loading (0 uses the number of hardware threads)
+    *
+    *  @remarks
+    *    The loading threads are started by the first call to loadAsync().
     */
-    ResourceManager();
+    explicit ResourceManager(unsigned int numLoadingThreads = 0);
 
     /**
     *  @brief
@@ -97,6 +133,83 @@ public:
     template <typename T>
     T * load(const std::string & filename, const reflectionzeug::Variant & options = reflectionzeug::Variant(), std::function<void(int, int)> progress = std::function<void(int, int)>()) const;
 
+    /**
+    *  @brief
+    *    Get shared resource, loading it only if it is not cached
+    *
+    *  @param[in] filename
+    *    File name
+    *  @param[in] options
+    *    Options for loading resource, see documentation of specific loader for supported options
+    *
+    *  @return
+    *    Resource (can be null)
+    *
+    *  @remarks
+    *    The resource type has to be derived from globjects::Referenced.
+    *    Resources are identified by type, canonical path, modification
+    *    time of the file and options, so changed files are loaded again.
+    */
+    template <typename T>
+    globjects::ref_ptr<T> get(const std::string & filename, const reflectionzeug::Variant & options = reflectionzeug::Variant());
+
+    /**
+    *  @brief
+    *    Get cache of shared resources
+    *
+    *  @return
+    *    Resource cache, e.g., to adjust its budget or query statistics
+    */
+    ResourceCache & cache();
+    const ResourceCache & cache() const;
+
+    /**
+    *  @brief
+    *    Load resource from file on a loading thread
+    *
+    *  @param[in] filename
+    *    File name
+    *  @param[in] options
+    *    Options for loading resource, see documentation of specific loader for supported options
+    *  @param[in] progress
+    *    Callback function that is invoked on progress from the loading thread (can be empty)
+    *
+    *  @return
+    *    Request that delivers the resource (null if no loader supports the file type)
+    *
+    *  @remarks
+    *    If the loader requires the OpenGL context, the resource is only
+    *    created during a later call of processUploads().
+    */
+    template <typename T>
+    std::shared_ptr<LoadRequest<T>> loadAsync(const std::string & filename, const reflectionzeug::Variant & options = reflectionzeug::Variant(), std::function<void(int, int)> progress = std::function<void(int, int)>());
+
+    /**
+    *  @brief
+    *    Create the resources of asynchronous requests that are waiting for the OpenGL context
+    *
+    *  @param[in] budget
+    *    Time after which no further resource is created (zero creates all waiting resources)
+    *
+    *  @return
+    *    Number of created resources
+    *
+    *  @remarks
+    *    Has to be called on the thread owning the OpenGL context, e.g., before painting a frame.
+    *    Afterwards, cached resources that are no longer in use are released down to the budget
+    *    of the cache, see ResourceCache::trim().
+    */
+    size_t processUploads(ChronoTimer::Duration budget = ChronoTimer::Duration::zero());
+
+    /**
+    *  @brief
+    *    Check if any asynchronous request is neither finished nor canceled
+    *
+    *  @return
+    *    'true' if requests are pending, else 'false'
+    */
+    bool hasPendingRequests() const;
+
     /**
     *  @brief
     *    Store resource to file
@@ -130,10 +243,106 @@ protected:
     */
     std::string getFileExtension(const std::string & filename) const;
 
+    /**
+    *  @brief
+    *    Find loader for a file
+    *
+    *  @param[in] filename
+    *    Path to file (with filename and extension)
+    *
+    *  @return
+    *    Loader for the resource type that supports the file type, nullptr if there is none
+    */
+    template <typename T>
+    Loader<T> * findLoader(const std::string & filename) const;
+
+    /**
+    *  @brief
+    *    Find loader for a file
+    *
+    *  @param[in] typeId
+    *    Type id of the resource (see TypeToken)
+    *  @param[in] filename
+    *    Path to file (with filename and extension)
+    *
+    *  @return
+    *    Loader for the resource type that supports the file, nullptr if there is none
+    *
+    *  @remarks
+    *    If the extension is ambiguous or unknown, the first loader recognizing the
+    *    content of the file is used. If none does, the first loader registered for
+    *    the extension is used.
+    */
+    AbstractLoader * findLoader(size_t typeId, const std::string & filename) const;
+
+    /**
+    *  @brief
+    *    Find storer for a file
+    *
+    *  @param[in] typeId
+    *    Type id of the resource (see TypeToken)
+    *  @param[in] filename
+    *    Path to file (with filename and extension)
+    *
+    *  @return
+    *    First storer registered for the resource type that supports the file type, nullptr if there is none
+    */
+    AbstractStorer * findStorer(size_t typeId, const std::string & filename) const;
+
+    /**
+    *  @brief
+    *    Get the cache key of a resource
+    *
+    *  @param[in] typeId
+    *    Type id of the resource (see TypeToken)
+    *  @param[in] filename
+    *    Path to file
+    *  @param[in] options
+    *    Options for loading resource
+    *
+    *  @return
+    *    Key made of type, canonical path, modification time and options
+    */
+    std::string cacheKey(size_t typeId, const std::string & filename, const reflectionzeug::Variant & options) const;
+
+    /**
+    *  @brief
+    *    Start an asynchronous request on the loading threads
+    *
+    *  @param[in] request
+    *    Load request
+    */
+    void enqueue(const std::shared_ptr<AbstractLoadRequest> & request);
+
+
+protected:
+    using IndexKey = std::pair<size_t, std::string>;    /**< Resource type id and file extension */
+
+    struct IndexKeyHash
+    {
+        size_t operator()(const IndexKey & key) const
+        {
+            return key.first ^ (std::hash<std::string>()(key.second) + 0x9e3779b9 + (key.first << 6) + (key.first >> 2));
+        }
+    };
+
 
 protected:
     std::vector<AbstractLoader *> m_loaders;    /**< Available loaders */
     std::vector<AbstractStorer *> m_storers;    /**< Available storers */
+
+    std::unordered_map<IndexKey, std::vector<AbstractLoader *>, IndexKeyHash> m_loaderIndex;   /**< Loaders by type and extension, in order of registration */
+    std::unordered_map<IndexKey, std::vector<AbstractStorer *>, IndexKeyHash> m_storerIndex;   /**< Storers by type and extension, in order of registration */
+    std::unordered_map<size_t, std::vector<AbstractLoader *>> m_loadersByType;                 /**< Loaders by type, for files with unlisted extensions */
+    std::unordered_map<size_t, std::vector<AbstractStorer *>> m_storersByType;                 /**< Storers by type, for files with unlisted extensions */
+
+    unsigned int m_numLoadingThreads;
+    std::unique_ptr<ThreadPool> m_loadingThreads;                   /**< Created on first use */
+    mutable std::mutex m_requestMutex;
+    std::vector<std::shared_ptr<AbstractLoadRequest>> m_requests;   /**< Asynchronous requests that may not be done */
+    std::deque<std::shared_ptr<AbstractLoadRequest>> m_uploads;     /**< Requests waiting for the OpenGL context */
+
+    ResourceCache m_cache;  /**< Resources shared by get() */
 };
 
 
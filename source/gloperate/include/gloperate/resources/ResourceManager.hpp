@@ -4,7 +4,14 @@
 
 #include <gloperate/resources/ResourceManager.h>
 
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include <gloperate/pipeline/DataSize.h>
+#include <gloperate/pipeline/TypeToken.h>
 #include <gloperate/resources/Loader.h>
+#include <gloperate/resources/LoadRequest.h>
 #include <gloperate/resources/Storer.h>
 
 
@@ -15,48 +22,71 @@ namespace gloperate
 template <typename T>
 T * ResourceManager::load(const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> progress) const
 {
-    // Get file extension
-    std::string ext = getFileExtension(filename);
-
     // Find suitable loader
-    for (AbstractLoader * loader : m_loaders) {
-        // Check loader type
-        Loader<T> * concreteLoader = dynamic_cast<Loader<T> *>(loader);
-        if (concreteLoader) {
-            // Check if filetype is supported
-            if (concreteLoader->canLoad(ext)) {
-                // Use loader
-                return concreteLoader->load(filename, options, progress);
-            }
-        }
+    Loader<T> * loader = findLoader<T>(filename);
+    if (loader) {
+        // Use loader
+        return loader->load(filename, options, progress);
     }
 
     // No suitable loader found
     return nullptr;
 }
 
+template <typename T>
+globjects::ref_ptr<T> ResourceManager::get(const std::string & filename, const reflectionzeug::Variant & options)
+{
+    static_assert(std::is_base_of<globjects::Referenced, T>::value, "Shared resources have to be derived from globjects::Referenced");
+
+    const auto resource = m_cache.get(cacheKey(TypeToken<T>::id(), filename, options), [this, &filename, &options]()
+    {
+        T * resource = load<T>(filename, options);
+
+        // Types without a size specialization count at least their object size
+        const size_t bytes = resource ? std::max(DataSize<T *>::sizeInBytes(resource), sizeof(T)) : 0;
+
+        return std::make_pair(static_cast<globjects::Referenced *>(resource), bytes);
+    });
+
+    return globjects::ref_ptr<T>(static_cast<T *>(resource.get()));
+}
+
+template <typename T>
+std::shared_ptr<LoadRequest<T>> ResourceManager::loadAsync(const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> progress)
+{
+    // Find suitable loader
+    Loader<T> * loader = findLoader<T>(filename);
+    if (!loader) {
+        return nullptr;
+    }
+
+    // Start loading
+    auto request = std::make_shared<LoadRequest<T>>(*loader, filename, options, progress);
+    enqueue(request);
+
+    return request;
+}
+
 template <typename T>
 bool ResourceManager::store(const std::string & filename, T * resource, const reflectionzeug::Variant & options, std::function<void(int, int)> progress) const
 {
-    // Get file extension
-    std::string ext = getFileExtension(filename);
-
-    // Find suitable storer
-    for (AbstractStorer * storer : m_storers) {
-        // Check storer type
-        Storer<T> * concreteStorer = dynamic_cast<Storer<T> *>(storer);
-        if (concreteStorer) {
-            // Check if filetype is supported
-            if (concreteStorer->canStore(ext)) {
-                // Use store
-                return concreteStorer->store(filename, resource, options, progress);
-            }
-        }
+    // Find suitable storer (storers are indexed by their resource type, so the cast is safe)
+    Storer<T> * storer = static_cast<Storer<T> *>(findStorer(TypeToken<T>::id(), filename));
+    if (storer) {
+        // Use storer
+        return storer->store(filename, resource, options, progress);
     }
 
-    // No suitable loader found
+    // No suitable storer found
     return false;
 }
 
+template <typename T>
+Loader<T> * ResourceManager::findLoader(const std::string & filename) const
+{
+    // Loaders are indexed by their resource type, so the cast is safe
+    return static_cast<Loader<T> *>(findLoader(TypeToken<T>::id(), filename));
+}
+
 
 } // namespace gloperate
@@ -36,6 +36,9 @@ public:
     */
     virtual ~Storer();
 
+    // Virtual gloperate::AbstractStorer functions
+    virtual size_t resourceTypeId() const override;
+
     /**
     *  @brief
     *    Store resource to file
@@ -4,6 +4,8 @@
 
 #include <gloperate/resources/Storer.h>
 
+#include <gloperate/pipeline/TypeToken.h>
+
 
 namespace gloperate
 {
@@ -19,5 +21,11 @@ Storer<T>::~Storer()
 {
 }
 
+template <typename T>
+size_t Storer<T>::resourceTypeId() const
+{
+    return TypeToken<T>::id();
+}
+
 
 } // namespace gloperate
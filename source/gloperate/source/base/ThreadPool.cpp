@@ -0,0 +1,167 @@
+
+#include <gloperate/base/ThreadPool.h>
+
+#include <algorithm>
+
+
+namespace gloperate
+{
+
+
+ThreadPool::ThreadPool(unsigned int numThreads)
+:   m_nextWorker(0)
+,   m_numPending(0)
+,   m_running(true)
+{
+    if (numThreads == 0)
+    {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (unsigned int i = 0; i < numThreads; ++i)
+    {
+        m_workers.emplace_back(new Worker);
+    }
+
+    // Workers may already access the thread list while it is populated
+    m_threads.reserve(numThreads);
+
+    for (unsigned int i = 0; i < numThreads; ++i)
+    {
+        m_threads.emplace_back(&ThreadPool::run, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_running = false;
+    }
+
+    m_wakeUp.notify_all();
+
+    for (auto & thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+unsigned int ThreadPool::size() const
+{
+    return static_cast<unsigned int>(m_workers.size());
+}
+
+void ThreadPool::execute(Task task)
+{
+    // Tasks spawned by a worker stay local to that worker
+    auto index = m_nextWorker++ % size();
+    const auto id = std::this_thread::get_id();
+
+    for (unsigned int i = 0; i < size(); ++i)
+    {
+        if (m_threads[i].get_id() == id)
+        {
+            index = i;
+            break;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_workers[index]->mutex);
+        m_workers[index]->tasks.push_back(std::move(task));
+    }
+
+    ++m_numPending;
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+
+    m_wakeUp.notify_one();
+}
+
+bool ThreadPool::runPendingTask()
+{
+    Task task;
+
+    if (!stealTask(size(), task))
+    {
+        return false;
+    }
+
+    task();
+
+    return true;
+}
+
+void ThreadPool::run(unsigned int index)
+{
+    while (true)
+    {
+        Task task;
+
+        if (popTask(index, task) || stealTask(index, task))
+        {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+
+        m_wakeUp.wait(lock, [this]() { return m_numPending > 0 || !m_running; });
+
+        if (!m_running && m_numPending == 0)
+        {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::popTask(unsigned int index, Task & task)
+{
+    Worker & worker = *m_workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+
+    if (worker.tasks.empty())
+    {
+        return false;
+    }
+
+    // Own tasks are processed LIFO for cache locality
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+
+    --m_numPending;
+
+    return true;
+}
+
+bool ThreadPool::stealTask(unsigned int index, Task & task)
+{
+    const auto numWorkers = size();
+
+    for (unsigned int i = 1; i <= numWorkers; ++i)
+    {
+        Worker & victim = *m_workers[(index + i) % numWorkers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (victim.tasks.empty())
+        {
+            continue;
+        }
+
+        // Stolen tasks are taken FIFO, i.e., the oldest ones
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+
+        --m_numPending;
+
+        return true;
+    }
+
+    return false;
+}
+
+
+} // namespace gloperate
@@ -25,5 +25,15 @@ std::vector<AbstractData *> AbstractOutputCapability::findOutputs(const std::str
     return collection::select(allOutputs(), [&name](AbstractData * data) { return data->matchesName(name); });
 }
 
+AbstractData * AbstractOutputCapability::findOutput(const std::string & name, size_t typeId) const
+{
+    return collection::detect(findOutputs(name), [typeId](AbstractData * data) { return data->typeId() == typeId; }, nullptr);
+}
+
+AbstractData * AbstractOutputCapability::findOutputOfType(size_t typeId) const
+{
+    return collection::detect(allOutputs(), [typeId](AbstractData * data) { return data->typeId() == typeId; }, nullptr);
+}
+
 
 }
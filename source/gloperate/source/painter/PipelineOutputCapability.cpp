@@ -25,5 +25,20 @@ std::vector<gloperate::AbstractData*> PipelineOutputCapability::allOutputs() con
     return m_pipeline.allOutputs();
 }
 
+std::vector<gloperate::AbstractData*> PipelineOutputCapability::findOutputs(const std::string & name) const
+{
+    return m_pipeline.findOutputs(name);
+}
+
+gloperate::AbstractData * PipelineOutputCapability::findOutput(const std::string & name, size_t typeId) const
+{
+    return m_pipeline.findOutput(name, typeId);
+}
+
+gloperate::AbstractData * PipelineOutputCapability::findOutputOfType(size_t typeId) const
+{
+    return m_pipeline.findOutputOfType(typeId);
+}
+
 
 }
@@ -5,6 +5,8 @@
 #include <sstream>
 
 #include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/AbstractPipeline.h>
+#include <gloperate/pipeline/AbstractInputSlot.h>
 
 
 namespace gloperate 
@@ -14,11 +16,18 @@ namespace gloperate
 AbstractData::AbstractData(const std::string & name)
 : m_owner(nullptr)
 , m_name(name)
+, m_typeId(0)
+, m_pipeline(nullptr)
+, m_invalidationPending(false)
 {
 }
 
 AbstractData::~AbstractData()
 {
+    for (AbstractInputSlot * consumer : m_consumers)
+    {
+        consumer->dataDestroyed();
+    }
 }
 
 const std::string & AbstractData::name() const
@@ -29,6 +38,17 @@ const std::string & AbstractData::name() const
 void AbstractData::setName(const std::string & name)
 {
     m_name = name;
+
+    if (m_owner)
+    {
+        m_owner->outputsChanged();
+    }
+
+    // Parameters have no owner, the pipeline indexes them directly
+    if (m_pipeline)
+    {
+        m_pipeline->invalidateDataIndex();
+    }
 }
 
 bool AbstractData::hasName() const
@@ -76,14 +96,84 @@ std::string AbstractData::qualifiedName() const
     return ss.str();
 }
 
+void AbstractData::addConsumer(AbstractInputSlot * slot) const
+{
+    m_consumers.push_back(slot);
+}
+
+void AbstractData::removeConsumer(AbstractInputSlot * slot) const
+{
+    m_consumers.erase(std::remove(m_consumers.begin(), m_consumers.end(), slot), m_consumers.end());
+}
+
 void AbstractData::invalidate()
 {
+    AbstractPipeline * pipeline = m_owner ? m_owner->m_pipeline : m_pipeline;
+
+    // Within an update of the pipeline, the invalidation is delivered when the update ends
+    if (pipeline && pipeline->deferInvalidation(this))
+        return;
+
+    propagateInvalidation();
+}
+
+void AbstractData::propagateInvalidation()
+{
+    for (AbstractInputSlot * consumer : m_consumers)
+    {
+        consumer->changed();
+    }
+
     invalidated();
 }
 
+size_t AbstractData::typeId() const
+{
+    return m_typeId;
+}
+
+bool AbstractData::contentHash(size_t & /*hash*/) const
+{
+    return false;
+}
+
+bool AbstractData::canSnapshot() const
+{
+    return false;
+}
+
+std::shared_ptr<AbstractData> AbstractData::snapshot() const
+{
+    return nullptr;
+}
+
+bool AbstractData::restore(const AbstractData & /*snapshot*/)
+{
+    return false;
+}
+
+bool AbstractData::hasHistory() const
+{
+    return false;
+}
+
+size_t AbstractData::historyLength() const
+{
+    return 0;
+}
+
+void AbstractData::advanceHistory()
+{
+}
+
+size_t AbstractData::sizeInBytes() const
+{
+    return 0;
+}
+
 bool AbstractData::matchesName(const std::string & name) const
 {
-    return this->name() == name;
+    return this->name() == name || qualifiedName() == name;
 }
 
 
@@ -5,6 +5,7 @@
 #include <algorithm>
 
 #include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/AbstractData.h>
 
 
 namespace gloperate 
@@ -14,6 +15,7 @@ namespace gloperate
 AbstractInputSlot::AbstractInputSlot(const std::string & name)
 : m_owner(nullptr)
 , m_name(name)
+, m_typeId(0)
 , m_hasChanged(true)
 , m_isOptional(false)
 , m_isFeedback(false)
@@ -84,14 +86,39 @@ bool AbstractInputSlot::isUsable() const
     return isOptional() || isConnected();
 }
 
+size_t AbstractInputSlot::typeId() const
+{
+    return m_typeId;
+}
+
 bool AbstractInputSlot::hasChanged() const
 {
     return m_hasChanged;
 }
 
+void AbstractInputSlot::registerAt(const AbstractData & data)
+{
+    data.addConsumer(this);
+}
+
+void AbstractInputSlot::unregisterAt(const AbstractData & data)
+{
+    data.removeConsumer(this);
+}
+
 void AbstractInputSlot::changed()
 {
     m_hasChanged = true;
+
+    if (m_owner)
+    {
+        m_owner->markDirty();
+    }
+
+    for (AbstractStage * stage : m_sharingStages)
+    {
+        stage->markDirty();
+    }
 }
 
 void AbstractInputSlot::processed()
@@ -4,37 +4,72 @@
 #include <cassert>
 #include <string>
 #include <algorithm>
+#include <functional>
+#include <limits>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <iostream>
 
 #include <chrono>
+#include <future>
 #include <iostream>
 
-#include <gloperate/base/collection.hpp>
+#include <gloperate/base/ThreadPool.h>
 
 #include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/AsyncStage.h>
 #include <gloperate/pipeline/AbstractInputSlot.h>
 #include <gloperate/pipeline/AbstractData.h>
 #include <gloperate/pipeline/AbstractData.h>
 #include <gloperate/pipeline/Data.h>
+#include <gloperate/pipeline/ExecutionPlan.h>
+#include <gloperate/pipeline/MemoryTracker.h>
+#include <gloperate/pipeline/StageProfiler.h>
 
 
-using namespace collection;
+namespace
+{
+    const size_t noStage = std::numeric_limits<size_t>::max();
+}
 
 
 namespace gloperate
 {
 
 
+AbstractPipeline::BudgetUsage::BudgetUsage()
+:   budget(0)
+,   critical(0)
+,   deferred(0)
+,   processedDeferred(0)
+,   carriedOver(0)
+{
+}
+
+
 AbstractPipeline::AbstractPipeline(const std::string & name)
 :   m_initialized(false)
 ,   m_name(name)
 ,   m_dependenciesSorted(false)
+,   m_dataIndexValid(false)
+,   m_executingIndex(noStage)
+,   m_executingParallel(false)
+,   m_frameBudget(0)
+,   m_compiled(false)
+,   m_planOutdated(false)
+,   m_updateDepth(0)
 {
 }
 
 AbstractPipeline::~AbstractPipeline()
 {
+    // Running jobs may still access other stages
+    for (auto & asyncStage : m_asyncStages)
+    {
+        asyncStage->wait();
+    }
+
     for (auto & stage : m_stages)
     {
         delete stage;
@@ -74,13 +109,75 @@ std::string AbstractPipeline::asPrintable() const
 
 void AbstractPipeline::addStage(AbstractStage * stage)
 {
-    stage->dependenciesChanged.connect([this]() { m_dependenciesSorted = false; });
+    invalidatePlan();
+
+    stage->dependenciesChanged.connect([this, stage]() { stageDependenciesChanged(stage); });
+
+    stage->m_pipeline = this;
+    stage->m_pipelineIndex = m_stages.size();
     m_stages.push_back(stage);
+    m_stageLevels.clear();
+    m_dataIndexValid = false;
+
+    if (auto asyncStage = dynamic_cast<AsyncStage *>(stage))
+        m_asyncStages.push_back(asyncStage);
+
+    if (!m_dependenciesSorted)
+        return;
+
+    if (m_executingIndex != noStage || m_executingParallel)
+    {
+        m_dependenciesSorted = false;
+        return;
+    }
+
+    // All predecessors are already sorted, so only consumers of the new stage have to be moved
+    updatePredecessors(stage);
+
+    std::vector<AbstractStage *> consumers;
+
+    for (auto output : stage->allOutputs())
+    {
+        for (auto slot : output->m_consumers)
+        {
+            if (slot->isFeedback())
+                continue;
+
+            consumers.push_back(slot->m_owner);
+            consumers.insert(consumers.end(), slot->m_sharingStages.begin(), slot->m_sharingStages.end());
+        }
+    }
+
+    for (auto other : m_stages)
+    {
+        if (other->m_dependencies.count(stage) > 0)
+            consumers.push_back(other);
+    }
+
+    for (auto consumer : consumers)
+    {
+        if (!consumer || consumer->m_pipeline != this || consumer == stage)
+            continue;
+
+        for (auto predecessor : updatePredecessors(consumer))
+        {
+            if (!insertEdge(predecessor, consumer))
+            {
+                m_dependenciesSorted = false;
+                return;
+            }
+        }
+    }
+
+    if (stage->isDirty())
+        scheduleStage(stage);
 }
 
 void AbstractPipeline::addParameter(AbstractData * parameter)
 {
+    parameter->m_pipeline = this;
     m_parameters.push_back(parameter);
+    m_dataIndexValid = false;
 }
 
 void AbstractPipeline::shareData(const AbstractData* data)
@@ -113,22 +210,86 @@ const std::vector<AbstractData *> & AbstractPipeline::parameters() const
 
 std::vector<AbstractInputSlot *> AbstractPipeline::allInputs() const
 {
-    return flatten(collect(stages(), [](const AbstractStage * stage) { return stage->allInputs(); }));
+    std::vector<AbstractInputSlot *> inputs;
+
+    for (auto stage : stages())
+    {
+        inputs.insert(inputs.end(), stage->allInputs().begin(), stage->allInputs().end());
+    }
+
+    return inputs;
 }
 
 std::vector<AbstractData *> AbstractPipeline::allOutputs() const
 {
-    return flatten(collect(stages(), [](const AbstractStage * stage) { return stage->allOutputs(); }));
+    std::vector<AbstractData *> outputs;
+
+    for (auto stage : stages())
+    {
+        outputs.insert(outputs.end(), stage->allOutputs().begin(), stage->allOutputs().end());
+    }
+
+    return outputs;
 }
 
 AbstractData * AbstractPipeline::findParameter(const std::string & name) const
 {
-    return detect(m_parameters, [&name](AbstractData * parameter) { return parameter->matchesName(name); }, nullptr);
+    updateDataIndex();
+
+    const auto & parameters = m_parameterIndex.find(name);
+
+    return parameters.empty() ? nullptr : parameters.front();
 }
 
 std::vector<AbstractData *> AbstractPipeline::findOutputs(const std::string & name) const
 {
-    return select(allOutputs(), [&name](AbstractData * data) { return data->matchesName(name); });
+    updateDataIndex();
+
+    return m_outputIndex.find(name);
+}
+
+AbstractData * AbstractPipeline::findOutput(const std::string & name, size_t typeId) const
+{
+    updateDataIndex();
+
+    return m_outputIndex.find(name, typeId);
+}
+
+AbstractData * AbstractPipeline::findOutputOfType(size_t typeId) const
+{
+    updateDataIndex();
+
+    return m_outputIndex.findType(typeId);
+}
+
+void AbstractPipeline::invalidateDataIndex()
+{
+    m_dataIndexValid = false;
+}
+
+void AbstractPipeline::updateDataIndex() const
+{
+    if (m_dataIndexValid)
+        return;
+
+    m_parameterIndex.clear();
+    m_outputIndex.clear();
+
+    for (auto parameter : m_parameters)
+    {
+        m_parameterIndex.add(parameter);
+    }
+
+    // Same order as allOutputs()
+    for (auto stage : stages())
+    {
+        for (auto output : stage->allOutputs())
+        {
+            m_outputIndex.add(output);
+        }
+    }
+
+    m_dataIndexValid = true;
 }
 
 void AbstractPipeline::execute()
@@ -138,105 +299,1057 @@ void AbstractPipeline::execute()
         return;
     }
 
-    for (auto & stage: m_stages)
+    if (m_profiler)
+        m_profiler->beginFrame();
+
+    publishAsyncResults();
+
+    // Changes of an open update take effect before the stages are processed
+    deliverInvalidations();
+
+    if (m_compiled && !m_plan)
     {
-        stage->execute();
+        buildPlan();
     }
+
+    if (m_threadPool)
+    {
+        executeParallel();
+    }
+    else if (m_frameBudget > ChronoTimer::Duration::zero())
+    {
+        executeWithinBudget();
+    }
+    else if (m_plan)
+    {
+        executePlan(nullptr);
+    }
+    else
+    {
+        executeSequential();
+    }
+
+    if (m_profiler)
+        m_profiler->endFrame(m_stages);
 }
 
-bool AbstractPipeline::isInitialized() const
+void AbstractPipeline::setFrameBudget(ChronoTimer::Duration budget)
 {
-    return m_initialized;
+    m_frameBudget = budget;
 }
 
-void AbstractPipeline::initialize()
+ChronoTimer::Duration AbstractPipeline::frameBudget() const
 {
-    if (m_initialized)
+    return m_frameBudget;
+}
+
+const AbstractPipeline::BudgetUsage & AbstractPipeline::budgetUsage() const
+{
+    return m_budgetUsage;
+}
+
+bool AbstractPipeline::compile()
+{
+    m_compiled = true;
+
+    return m_plan || buildPlan();
+}
+
+bool AbstractPipeline::isCompiled() const
+{
+    return m_compiled;
+}
+
+void AbstractPipeline::discardPlan()
+{
+    m_compiled = false;
+
+    invalidatePlan();
+}
+
+bool AbstractPipeline::buildPlan()
+{
+    if (!m_dependenciesSorted && !sortDependencies())
+        return false;
+
+    m_plan.reset(new ExecutionPlan(m_stages));
+    m_planOutdated = false;
+
+    // Dirty stages are tracked by the plan from now on
+    m_scheduledStages.clear();
+    m_deferredStages.clear();
+
+    return true;
+}
+
+void AbstractPipeline::invalidatePlan()
+{
+    if (!m_plan)
         return;
 
-    m_initialized = initializeStages();
+    if (m_executingIndex != noStage)
+    {
+        // The plan is still being iterated
+        m_planOutdated = true;
+        return;
+    }
+
+    m_plan.reset();
+    m_planOutdated = false;
+
+    rebuildSchedule();
 }
 
-bool AbstractPipeline::initializeStages()
+void AbstractPipeline::setParallelExecution(bool enabled, unsigned int numThreads)
 {
-    if (!m_dependenciesSorted)
+    if (!enabled)
     {
-        if (!sortDependencies())
-            return false;
+        m_threadPool.reset();
+        return;
     }
 
-    for (auto & stage : m_stages)
+    if (m_threadPool && (numThreads == 0 || m_threadPool->size() == numThreads))
+        return;
+
+    m_threadPool.reset(new ThreadPool(numThreads));
+}
+
+bool AbstractPipeline::parallelExecution() const
+{
+    return m_threadPool != nullptr;
+}
+
+void AbstractPipeline::setProfiling(bool enabled, size_t historySize)
+{
+    if (!enabled)
     {
-        stage->initialize();
+        m_profiler.reset();
+        return;
     }
 
-    return true;
+    if (m_profiler)
+    {
+        m_profiler->setHistorySize(historySize);
+        return;
+    }
+
+    m_profiler.reset(new StageProfiler(historySize));
 }
 
-bool AbstractPipeline::sortDependencies()
+bool AbstractPipeline::profiling() const
 {
-    if (m_dependenciesSorted)
-        return true;
+    return m_profiler != nullptr;
+}
 
-    m_dependenciesSorted = tsort(m_stages);
-    return m_dependenciesSorted;
+StageProfiler * AbstractPipeline::profiler() const
+{
+    return m_profiler.get();
 }
 
-void AbstractPipeline::addStages()
+void AbstractPipeline::writeTrace(std::ostream & stream) const
 {
+    if (m_profiler)
+    {
+        m_profiler->writeTrace(stream);
+    }
+    else
+    {
+        std::cerr << "Cannot write trace of " << asPrintable() << ": profiling is disabled" << std::endl;
+    }
 }
 
-bool AbstractPipeline::tsort(std::vector<AbstractStage *> & stages)
+void AbstractPipeline::writeProfileSummary(std::ostream & stream) const
 {
-    auto couldBeSorted = true;
-    std::vector<AbstractStage *> sorted;
-    std::set<AbstractStage *> touched;
+    if (m_profiler)
+    {
+        m_profiler->writeSummary(stream);
+    }
+    else
+    {
+        std::cerr << "Cannot write profile summary of " << asPrintable() << ": profiling is disabled" << std::endl;
+    }
+}
+
+void AbstractPipeline::setMemoryTracking(bool enabled)
+{
+    if (!enabled)
+    {
+        m_memoryTracker.reset();
+        return;
+    }
+
+    if (!m_memoryTracker)
+        m_memoryTracker.reset(new MemoryTracker);
+}
+
+bool AbstractPipeline::memoryTracking() const
+{
+    return m_memoryTracker != nullptr;
+}
+
+MemoryTracker * AbstractPipeline::memoryTracker() const
+{
+    return m_memoryTracker.get();
+}
+
+MemoryReport AbstractPipeline::memoryReport() const
+{
+    MemoryReport report;
+
+    const auto item = [this](const AbstractData * data)
+    {
+        MemoryReport::Item item;
+        item.name = data->qualifiedName();
+        item.bytes = data->sizeInBytes();
+        item.peakBytes = std::max(item.bytes, m_memoryTracker ? m_memoryTracker->peakBytes(data) : 0);
+        item.connected = !data->m_consumers.empty();
+
+        return item;
+    };
+
+    for (const AbstractData * parameter : m_parameters)
+    {
+        report.parameters.push_back(item(parameter));
+        report.totalBytes += report.parameters.back().bytes;
+    }
 
-    std::function<void(AbstractStage *)> visit = [&](AbstractStage * stage)
+    // Parameters are not tracked, their current size is part of the peak
+    const size_t parameterBytes = report.totalBytes;
+
+    for (const AbstractStage * stage : m_stages)
     {
-        if (!couldBeSorted)
+        MemoryReport::Stage stageReport;
+        stageReport.name = stage->name();
+        stageReport.cacheBytes = stage->cache() ? stage->cache()->sizeInBytes() : 0;
+        stageReport.bytes = stageReport.cacheBytes;
+        stageReport.enabled = stage->isEnabled();
+
+        for (const AbstractData * output : stage->outputs())
         {
-            sorted.push_back(stage);
-            return;
+            stageReport.outputs.push_back(item(output));
+            stageReport.bytes += stageReport.outputs.back().bytes;
         }
 
-        if (touched.count(stage) > 0)
+        stageReport.peakBytes = std::max(stageReport.bytes, m_memoryTracker ? m_memoryTracker->peakBytes(stage) : 0);
+
+        report.totalBytes += stageReport.bytes;
+        report.stages.push_back(std::move(stageReport));
+    }
+
+    report.peakBytes = std::max(report.totalBytes, m_memoryTracker ? m_memoryTracker->peakBytes() + parameterBytes : 0);
+
+    return report;
+}
+
+void AbstractPipeline::writeMemoryReport(std::ostream & stream) const
+{
+    memoryReport().writeSummary(stream);
+}
+
+void AbstractPipeline::beginUpdate()
+{
+    ++m_updateDepth;
+}
+
+void AbstractPipeline::endUpdate()
+{
+    assert(m_updateDepth > 0);
+
+    if (m_updateDepth == 0 || --m_updateDepth > 0)
+        return;
+
+    deliverInvalidations();
+}
+
+bool AbstractPipeline::isUpdating() const
+{
+    return m_updateDepth > 0;
+}
+
+bool AbstractPipeline::deferInvalidation(AbstractData * data)
+{
+    // Outputs invalidated by executing stages have to reach their consumers in the same sweep
+    if (m_updateDepth == 0 || m_executingIndex != noStage || m_executingParallel)
+        return false;
+
+    if (!data->m_invalidationPending)
+    {
+        data->m_invalidationPending = true;
+        m_pendingInvalidations.push_back(data);
+    }
+
+    return true;
+}
+
+void AbstractPipeline::deliverInvalidations()
+{
+    // Handlers may start another update, which collects into fresh lists
+    std::vector<AbstractStage *> stages;
+    std::vector<AbstractData *> invalidations;
+
+    stages.swap(m_pendingStages);
+    invalidations.swap(m_pendingInvalidations);
+
+    // Dependencies first, so the invalidated stages are scheduled in their new order
+    for (auto stage : stages)
+    {
+        updateDependencies(stage);
+    }
+
+    for (auto data : invalidations)
+    {
+        data->m_invalidationPending = false;
+        data->propagateInvalidation();
+    }
+}
+
+void AbstractPipeline::publishAsyncResults()
+{
+    // Swapping the buffers invalidates the outputs, so their consumers are processed in this execution
+    for (auto & asyncStage : m_asyncStages)
+    {
+        asyncStage->publish();
+    }
+}
+
+void AbstractPipeline::executeSequential()
+{
+    if (!m_dependenciesSorted && !sortDependencies())
+    {
+        // Without a valid order, fall back to visiting every stage
+        for (auto & stage: m_stages)
         {
-            std::cerr << "Pipeline is not a directed acyclic graph" << std::endl;
-            couldBeSorted = false;
-            sorted.push_back(stage);
-            return;
+            stage->execute();
         }
 
-        touched.insert(stage);
+        return;
+    }
 
-        for (auto stageIt = stages.begin(); stageIt != stages.end(); /* nop */)
-        {
-            if (!stage->requires(*stageIt, false))
-            {
-                ++stageIt;
-                continue;
-            }
+    processScheduledStages(nullptr);
+}
 
-            auto nextStage = *stageIt;
-            stages.erase(stageIt);
-            visit(nextStage);
+void AbstractPipeline::evaluate(AbstractData * output)
+{
+    evaluate(std::vector<AbstractData *>{ output });
+}
 
-            stageIt = stages.begin();
-        }
+void AbstractPipeline::evaluate(const std::vector<AbstractData *> & outputs)
+{
+    if (!m_initialized)
+    {
+        return;
+    }
 
-        sorted.push_back(stage);
-    };
+    publishAsyncResults();
+
+    // Changes of an open update take effect before the required stages are determined
+    deliverInvalidations();
 
-    while (!stages.empty())
+    if (!m_dependenciesSorted && !sortDependencies())
     {
-        auto stageIt = stages.begin();
-        auto stage = *stageIt;
-        stages.erase(stageIt);
-        visit(stage);
+        std::cerr << "Cannot evaluate outputs of " << asPrintable() << ": pipeline is not a directed acyclic graph" << std::endl;
+        return;
+    }
+
+    if (m_compiled && !m_plan)
+    {
+        buildPlan();
+    }
+
+    const auto required = requiredStages(outputs);
+
+    if (m_profiler)
+        m_profiler->beginFrame();
+
+    executeRequired(required);
+
+    if (m_profiler)
+        m_profiler->endFrame(m_stages);
+}
+
+void AbstractPipeline::processScheduledStages(const std::vector<bool> * requiredStages)
+{
+    for (auto index : m_deferredStages)
+    {
+        m_scheduledStages.push_back(index);
+        std::push_heap(m_scheduledStages.begin(), m_scheduledStages.end(), std::greater<size_t>());
+    }
+
+    m_deferredStages.clear();
+
+    // Stages invalidated during the sweep come later in the order and are pushed onto the heap
+    std::vector<size_t> skippedStages;
+    auto lastIndex = noStage;
+
+    while (!m_scheduledStages.empty())
+    {
+        std::pop_heap(m_scheduledStages.begin(), m_scheduledStages.end(), std::greater<size_t>());
+        m_executingIndex = m_scheduledStages.back();
+        m_scheduledStages.pop_back();
+
+        if (m_executingIndex == lastIndex)
+            continue;
+
+        lastIndex = m_executingIndex;
+
+        if (requiredStages && !(*requiredStages)[m_executingIndex])
+        {
+            skippedStages.push_back(m_executingIndex);
+            continue;
+        }
+
+        AbstractStage * stage = m_stages[m_executingIndex];
+        stage->execute();
+
+        if (stage->isDirty())
+            m_deferredStages.push_back(m_executingIndex);
+    }
+
+    m_executingIndex = noStage;
+
+    // Skipped stages are still dirty and stay scheduled
+    for (auto index : skippedStages)
+    {
+        m_scheduledStages.push_back(index);
+        std::push_heap(m_scheduledStages.begin(), m_scheduledStages.end(), std::greater<size_t>());
+    }
+}
+
+void AbstractPipeline::executeWithinBudget()
+{
+    if (!m_dependenciesSorted && !sortDependencies())
+    {
+        executeSequential();
+        return;
+    }
+
+    ChronoTimer timer;
+
+    std::vector<bool> critical(m_stages.size());
+
+    for (size_t i = 0; i < m_stages.size(); ++i)
+    {
+        critical[i] = !m_stages[i]->isDeferrable();
+    }
+
+    executeRequired(critical);
+
+    m_budgetUsage = BudgetUsage();
+    m_budgetUsage.budget = m_frameBudget;
+    m_budgetUsage.critical = timer.elapsed();
+
+    // Stages are sorted, so the first of equal priority comes first in the order
+    std::vector<AbstractStage *> candidates;
+
+    for (auto stage : m_stages)
+    {
+        if (stage->isDeferrable())
+            candidates.push_back(stage);
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(), [](const AbstractStage * lhs, const AbstractStage * rhs)
+    {
+        return lhs->priority() > rhs->priority();
+    });
+
+    // Stages that stay dirty after an attempt (e.g., unusable ones) are not attempted again,
+    // stages that become dirty in the meantime are found by the next pass
+    std::vector<bool> attempted(m_stages.size(), false);
+    bool attemptedAny = true;
+
+    while (attemptedAny && timer.elapsed() < m_frameBudget)
+    {
+        attemptedAny = false;
+
+        for (auto stage : candidates)
+        {
+            if (timer.elapsed() >= m_frameBudget)
+                break;
+
+            const auto index = stage->m_pipelineIndex;
+
+            if (attempted[index] || !stage->isDirty() || !stage->isEnabled())
+                continue;
+
+            attempted[index] = true;
+            attemptedAny = true;
+
+            if (executeStage(index))
+                ++m_budgetUsage.processedDeferred;
+        }
+    }
+
+    m_budgetUsage.deferred = timer.elapsed() - m_budgetUsage.critical;
+    m_budgetUsage.carriedOver = std::count_if(m_stages.begin(), m_stages.end(), [](const AbstractStage * stage)
+    {
+        return stage->isDeferrable() && stage->isDirty();
+    });
+}
+
+bool AbstractPipeline::executeStage(size_t index)
+{
+    AbstractStage * stage = m_stages[index];
+
+    m_executingIndex = index;
+
+    bool processed = false;
+
+    if (m_plan)
+    {
+        processed = stage->m_enabled && m_plan->isUsable(index);
+
+        if (processed)
+        {
+            m_plan->unschedule(index);
+            stage->run();
+
+            if (stage->isDirty())
+                m_plan->schedule(index);
+        }
+    }
+    else
+    {
+        // An entry on the scheduling heap is skipped by the next sweep once the stage is processed
+        processed = stage->execute();
+
+        if (stage->isDirty())
+            m_deferredStages.push_back(index);
+    }
+
+    m_executingIndex = noStage;
+
+    if (m_planOutdated)
+    {
+        invalidatePlan();
+    }
+
+    return processed;
+}
+
+void AbstractPipeline::executeRequired(const std::vector<bool> & requiredStages)
+{
+    if (m_plan)
+    {
+        executePlan(&requiredStages);
+    }
+    else
+    {
+        processScheduledStages(&requiredStages);
+    }
+}
+
+void AbstractPipeline::executePlan(const std::vector<bool> * requiredStages)
+{
+    ExecutionPlan & plan = *m_plan;
+
+    // Stages that stay dirty are scheduled again after the sweep
+    std::vector<size_t> pendingStages;
+
+    // Stages invalidated during the sweep come later in the order and are found by the scan
+    for (auto index = plan.nextScheduled(0); index != ExecutionPlan::npos; index = plan.nextScheduled(index + 1))
+    {
+        plan.unschedule(index);
+
+        AbstractStage * stage = plan.stage(index);
+
+        if ((requiredStages && !(*requiredStages)[index]) || !stage->m_enabled || !plan.isUsable(index))
+        {
+            pendingStages.push_back(index);
+            continue;
+        }
+
+        m_executingIndex = index;
+        stage->run();
+
+        if (stage->isDirty())
+            pendingStages.push_back(index);
+    }
+
+    m_executingIndex = noStage;
+
+    for (auto index : pendingStages)
+    {
+        plan.schedule(index);
+    }
+
+    if (m_planOutdated)
+    {
+        invalidatePlan();
+    }
+}
+
+std::vector<bool> AbstractPipeline::requiredStages(const std::vector<AbstractData *> & outputs) const
+{
+    std::vector<bool> required(m_stages.size(), false);
+    std::vector<const AbstractStage *> stack;
+
+    auto require = [this, &required, &stack](const AbstractStage * stage)
+    {
+        if (!stage || stage->m_pipeline != this || required[stage->m_pipelineIndex])
+            return;
+
+        required[stage->m_pipelineIndex] = true;
+        stack.push_back(stage);
+    };
+
+    for (auto output : outputs)
+    {
+        require(output->owner());
+    }
+
+    // Walk back along the dependencies; feedback inputs refer to the previous execution
+    while (!stack.empty())
+    {
+        const AbstractStage * stage = stack.back();
+        stack.pop_back();
+
+        for (auto predecessor : stage->m_predecessors)
+        {
+            require(predecessor);
+        }
+    }
+
+    return required;
+}
+
+void AbstractPipeline::executeParallel()
+{
+    if (!m_dependenciesSorted && !sortDependencies())
+    {
+        // Levels cannot be determined for cyclic pipelines
+        executeSequential();
+        return;
+    }
+
+    if (m_stageLevels.empty())
+    {
+        computeStageLevels();
+    }
+
+    // Every dirty stage is visited level by level, so no scheduling is necessary
+    m_executingParallel = true;
+
+    std::vector<std::future<bool>> results;
+
+    for (const auto & level : m_stageLevels)
+    {
+        // Dispatch stages that are free to run on any thread
+        if (level.size() > 1)
+        {
+            for (auto stage : level)
+            {
+                if (stage->isDirty() && !stage->requiresContext())
+                    results.push_back(m_threadPool->submit([stage]() { return stage->execute(); }));
+            }
+        }
+
+        // Execute context-bound stages meanwhile
+        for (auto stage : level)
+        {
+            if (level.size() == 1 || stage->requiresContext())
+                stage->execute();
+        }
+
+        // Barrier: the next level may depend on any stage of this one
+        for (auto & result : results)
+        {
+            m_threadPool->wait(result);
+            result.get();
+        }
+
+        results.clear();
+    }
+
+    m_executingParallel = false;
+
+    rebuildSchedule();
+}
+
+void AbstractPipeline::computeStageLevels()
+{
+    m_stageLevels.clear();
+
+    // Stages are sorted, so all predecessors of a stage already have their level
+    std::vector<size_t> levels(m_stages.size(), 0);
+
+    for (size_t i = 0; i < m_stages.size(); ++i)
+    {
+        for (auto predecessor : m_stages[i]->m_predecessors)
+        {
+            levels[i] = std::max(levels[i], levels[predecessor->m_pipelineIndex] + 1);
+        }
+
+        if (levels[i] >= m_stageLevels.size())
+            m_stageLevels.resize(levels[i] + 1);
+
+        m_stageLevels[levels[i]].push_back(m_stages[i]);
+    }
+}
+
+bool AbstractPipeline::isInitialized() const
+{
+    return m_initialized;
+}
+
+void AbstractPipeline::initialize()
+{
+    if (m_initialized)
+        return;
+
+    m_initialized = initializeStages();
+}
+
+bool AbstractPipeline::initializeStages()
+{
+    if (!m_dependenciesSorted)
+    {
+        if (!sortDependencies())
+            return false;
+    }
+
+    for (auto & stage : m_stages)
+    {
+        stage->initialize();
+    }
+
+    return true;
+}
+
+bool AbstractPipeline::sortDependencies()
+{
+    if (m_dependenciesSorted)
+        return true;
+
+    for (size_t i = 0; i < m_stages.size(); ++i)
+    {
+        m_stages[i]->m_pipelineIndex = i;
+        m_stages[i]->m_predecessors.clear();
+        m_stages[i]->m_successors.clear();
+    }
+
+    for (auto stage : m_stages)
+    {
+        updatePredecessors(stage);
+    }
+
+    m_dependenciesSorted = tsort(m_stages);
+    m_dataIndexValid = false;
+
+    rebuildSchedule();
+
+    return m_dependenciesSorted;
+}
+
+void AbstractPipeline::stageDependenciesChanged(AbstractStage * stage)
+{
+    m_stageLevels.clear();
+
+    invalidatePlan();
+
+    if (m_updateDepth > 0)
+    {
+        if (std::find(m_pendingStages.begin(), m_pendingStages.end(), stage) == m_pendingStages.end())
+            m_pendingStages.push_back(stage);
+
+        return;
+    }
+
+    updateDependencies(stage);
+}
+
+void AbstractPipeline::updateDependencies(AbstractStage * stage)
+{
+    if (!m_dependenciesSorted)
+        return;
+
+    if (m_executingIndex != noStage || m_executingParallel)
+    {
+        // Do not reorder stages during a sweep, resort before the next one
+        m_dependenciesSorted = false;
+        return;
+    }
+
+    for (auto predecessor : updatePredecessors(stage))
+    {
+        if (!insertEdge(predecessor, stage))
+        {
+            m_dependenciesSorted = false;
+            return;
+        }
+    }
+}
+
+std::vector<AbstractStage *> AbstractPipeline::updatePredecessors(AbstractStage * stage)
+{
+    std::vector<AbstractStage *> predecessors;
+
+    auto add = [this, &predecessors](const AbstractStage * predecessor)
+    {
+        if (!predecessor || predecessor->m_pipeline != this)
+            return;
+
+        AbstractStage * mutablePredecessor = m_stages[predecessor->m_pipelineIndex];
+
+        if (std::find(predecessors.begin(), predecessors.end(), mutablePredecessor) == predecessors.end())
+            predecessors.push_back(mutablePredecessor);
+    };
+
+    for (auto input : stage->allInputs())
+    {
+        if (!input->isFeedback() && input->connectedData())
+            add(input->connectedData()->owner());
+    }
+
+    for (auto dependency : stage->m_dependencies)
+    {
+        add(dependency);
+    }
+
+    // Update the reverse edges and report the new ones
+    std::vector<AbstractStage *> added;
+
+    for (auto predecessor : stage->m_predecessors)
+    {
+        if (std::find(predecessors.begin(), predecessors.end(), predecessor) == predecessors.end())
+        {
+            auto & successors = predecessor->m_successors;
+            successors.erase(std::remove(successors.begin(), successors.end(), stage), successors.end());
+        }
+    }
+
+    for (auto predecessor : predecessors)
+    {
+        if (std::find(stage->m_predecessors.begin(), stage->m_predecessors.end(), predecessor) == stage->m_predecessors.end())
+        {
+            predecessor->m_successors.push_back(stage);
+            added.push_back(predecessor);
+        }
+    }
+
+    stage->m_predecessors = std::move(predecessors);
+
+    return added;
+}
+
+bool AbstractPipeline::insertEdge(AbstractStage * from, AbstractStage * to)
+{
+    // Dynamic topological sort (Pearce & Kelly): only the stages between both ends may move
+    const auto lowerBound = to->m_pipelineIndex;
+    const auto upperBound = from->m_pipelineIndex;
+
+    if (upperBound < lowerBound)
+        return true;
+
+    if (from == to)
+    {
+        std::cerr << "Pipeline is not a directed acyclic graph" << std::endl;
+        return false;
+    }
+
+    std::vector<AbstractStage *> forward;
+    std::vector<AbstractStage *> backward;
+    std::unordered_set<AbstractStage *> visited;
+    std::vector<AbstractStage *> stack;
+
+    // Stages reachable from 'to' that are ordered before 'from'
+    stack.push_back(to);
+    visited.insert(to);
+
+    while (!stack.empty())
+    {
+        AbstractStage * stage = stack.back();
+        stack.pop_back();
+        forward.push_back(stage);
+
+        for (auto successor : stage->m_successors)
+        {
+            if (successor == from)
+            {
+                std::cerr << "Pipeline is not a directed acyclic graph" << std::endl;
+                return false;
+            }
+
+            if (successor->m_pipelineIndex < upperBound && visited.insert(successor).second)
+                stack.push_back(successor);
+        }
+    }
+
+    // Stages reaching 'from' that are ordered after 'to'
+    stack.push_back(from);
+    visited.insert(from);
+
+    while (!stack.empty())
+    {
+        AbstractStage * stage = stack.back();
+        stack.pop_back();
+        backward.push_back(stage);
+
+        for (auto predecessor : stage->m_predecessors)
+        {
+            if (predecessor->m_pipelineIndex > lowerBound && visited.insert(predecessor).second)
+                stack.push_back(predecessor);
+        }
+    }
+
+    auto byIndex = [](const AbstractStage * lhs, const AbstractStage * rhs) { return lhs->m_pipelineIndex < rhs->m_pipelineIndex; };
+    std::sort(forward.begin(), forward.end(), byIndex);
+    std::sort(backward.begin(), backward.end(), byIndex);
+
+    // Reuse the freed positions, placing the backward set before the forward set
+    std::vector<size_t> positions;
+
+    for (auto stage : backward)
+        positions.push_back(stage->m_pipelineIndex);
+
+    for (auto stage : forward)
+        positions.push_back(stage->m_pipelineIndex);
+
+    std::sort(positions.begin(), positions.end());
+
+    backward.insert(backward.end(), forward.begin(), forward.end());
+
+    std::unordered_map<size_t, size_t> movedIndices;
+
+    for (size_t i = 0; i < backward.size(); ++i)
+    {
+        movedIndices[backward[i]->m_pipelineIndex] = positions[i];
+
+        backward[i]->m_pipelineIndex = positions[i];
+        m_stages[positions[i]] = backward[i];
+    }
+
+    // Scheduled stages refer to positions
+    for (auto & index : m_scheduledStages)
+    {
+        auto it = movedIndices.find(index);
+        if (it != movedIndices.end())
+            index = it->second;
+    }
+
+    for (auto & index : m_deferredStages)
+    {
+        auto it = movedIndices.find(index);
+        if (it != movedIndices.end())
+            index = it->second;
+    }
+
+    std::make_heap(m_scheduledStages.begin(), m_scheduledStages.end(), std::greater<size_t>());
+
+    // Lookups return data in the order of the stages
+    m_dataIndexValid = false;
+
+    return true;
+}
+
+void AbstractPipeline::scheduleStage(AbstractStage * stage)
+{
+    if (!m_dependenciesSorted || m_executingParallel)
+        return;
+
+    const auto index = stage->m_pipelineIndex;
+
+    if (m_plan)
+    {
+        // Stages added after the plan has been built are scheduled when it is discarded
+        if (index < m_plan->size())
+            m_plan->schedule(index);
+
+        return;
+    }
+
+    if (m_executingIndex != noStage && index <= m_executingIndex)
+    {
+        // Feedback to a stage that has already been visited is handled in the next execution
+        if (index < m_executingIndex)
+            m_deferredStages.push_back(index);
+
+        return;
+    }
+
+    m_scheduledStages.push_back(index);
+    std::push_heap(m_scheduledStages.begin(), m_scheduledStages.end(), std::greater<size_t>());
+}
+
+void AbstractPipeline::rebuildSchedule()
+{
+    m_scheduledStages.clear();
+    m_deferredStages.clear();
+
+    for (size_t i = 0; i < m_stages.size(); ++i)
+    {
+        m_stages[i]->m_pipelineIndex = i;
+    }
+
+    if (m_plan)
+    {
+        m_plan->reschedule();
+        return;
+    }
+
+    // An ascending sequence is a valid min-heap
+    for (size_t i = 0; i < m_stages.size(); ++i)
+    {
+        if (m_stages[i]->isDirty())
+            m_scheduledStages.push_back(i);
+    }
+}
+
+void AbstractPipeline::addStages()
+{
+}
+
+bool AbstractPipeline::tsort(std::vector<AbstractStage *> & stages)
+{
+    // Kahn's algorithm on the cached adjacency; the ready stages form a
+    // min-heap over their current index, so independent stages keep their order
+    std::vector<size_t> inDegree(stages.size(), 0);
+    std::vector<size_t> ready;
+
+    for (size_t i = 0; i < stages.size(); ++i)
+    {
+        stages[i]->m_pipelineIndex = i;
+        inDegree[i] = stages[i]->m_predecessors.size();
+
+        if (inDegree[i] == 0)
+            ready.push_back(i);
+    }
+
+    std::vector<AbstractStage *> sorted;
+    sorted.reserve(stages.size());
+
+    // An ascending sequence is a valid min-heap
+    while (!ready.empty())
+    {
+        std::pop_heap(ready.begin(), ready.end(), std::greater<size_t>());
+        AbstractStage * stage = stages[ready.back()];
+        ready.pop_back();
+
+        sorted.push_back(stage);
+
+        for (auto successor : stage->m_successors)
+        {
+            if (--inDegree[successor->m_pipelineIndex] == 0)
+            {
+                ready.push_back(successor->m_pipelineIndex);
+                std::push_heap(ready.begin(), ready.end(), std::greater<size_t>());
+            }
+        }
+    }
+
+    const auto couldBeSorted = sorted.size() == stages.size();
+
+    if (!couldBeSorted)
+    {
+        std::cerr << "Pipeline is not a directed acyclic graph" << std::endl;
+
+        for (size_t i = 0; i < stages.size(); ++i)
+        {
+            if (inDegree[i] > 0)
+                sorted.push_back(stages[i]);
+        }
     }
 
-    stages = sorted;
+    stages = std::move(sorted);
 
     return couldBeSorted;
 }
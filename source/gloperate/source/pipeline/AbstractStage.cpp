@@ -5,8 +5,13 @@
 #include <algorithm>
 #include <iterator>
 
+#include <gloperate/base/ChronoTimer.h>
+
 #include <gloperate/pipeline/AbstractInputSlot.h>
 #include <gloperate/pipeline/AbstractData.h>
+#include <gloperate/pipeline/AbstractPipeline.h>
+#include <gloperate/pipeline/MemoryTracker.h>
+#include <gloperate/pipeline/StageProfiler.h>
 
 
 namespace gloperate
@@ -15,10 +20,18 @@ namespace gloperate
 
 AbstractStage::AbstractStage(const std::string & name)
 : m_enabled(true)
+, m_requiresContext(false)
+, m_deferrable(false)
+, m_priority(0)
 , m_alwaysProcess(false)
 , m_processScheduled(false)
 , m_scheduledManually(false)
+, m_dirty(true)
 , m_name(name)
+, m_numOwnOutputs(0)
+, m_numOwnInputs(0)
+, m_pipeline(nullptr)
+, m_pipelineIndex(0)
 {
     dependenciesChanged.connect([this]() { m_usable.invalidate(); });
 }
@@ -35,6 +48,9 @@ const std::string & AbstractStage::name() const
 void AbstractStage::setName(const std::string & name)
 {
     m_name = name;
+
+    // Qualified names of the outputs have changed
+    outputsChanged();
 }
 
 bool AbstractStage::hasName() const
@@ -55,38 +71,121 @@ std::string AbstractStage::asPrintable() const
 
 bool AbstractStage::execute()
 {
-    if (!m_enabled)
+    if (!m_enabled || !inputsUsable() || !needsToProcess())
         return false;
 
-    if (!inputsUsable())
-        return false;
+    run();
 
-    if (needsToProcess()) {
-        m_scheduledManually = m_processScheduled;
-        m_processScheduled = false;
+    return true;
+}
 
-        process();
-        m_scheduledManually = false;
-    } else {
-        return false;
+void AbstractStage::run()
+{
+    m_dirty = false;
+    m_scheduledManually = m_processScheduled;
+    m_processScheduled = false;
+
+    for (AbstractData * output : m_historyOutputs)
+    {
+        output->advanceHistory();
+    }
+
+    // Memoized outputs replace processing if the inputs have been seen before
+    StageCache::Key cacheKey;
+    const bool cacheable = m_cache && inputHashes(cacheKey);
+
+    if (!cacheable || !m_cache->restore(cacheKey, outputs()))
+    {
+        // Profiling is disabled unless the pipeline owns a profiler
+        StageProfiler * profiler = m_pipeline ? m_pipeline->m_profiler.get() : nullptr;
+
+        if (profiler)
+        {
+            const auto start = profiler->timestamp();
+            ChronoTimer timer;
+
+            process();
+
+            profiler->recordExecution(this, start, timer.elapsed());
+        }
+        else
+        {
+            process();
+        }
+
+        if (cacheable)
+            m_cache->store(cacheKey, outputs());
     }
-    
+
+    if (m_pipeline && m_pipeline->m_memoryTracker)
+        m_pipeline->m_memoryTracker->recordStage(*this);
+
+    m_scheduledManually = false;
+
     markInputsProcessed();
-    
-    return true;
+
+    if (m_alwaysProcess || m_inputs.empty())
+    {
+        m_dirty = true;
+    }
 }
 
 void AbstractStage::initialize()
 {
 }
 
-bool AbstractStage::needsToProcess() const
+void AbstractStage::setMemoization(bool enabled, size_t capacity)
+{
+    if (!enabled)
+    {
+        m_cache.reset();
+        return;
+    }
+
+    if (m_cache)
+    {
+        m_cache->setCapacity(capacity);
+        return;
+    }
+
+    m_cache.reset(new StageCache(capacity));
+}
+
+bool AbstractStage::memoization() const
+{
+    return m_cache != nullptr;
+}
+
+const StageCache * AbstractStage::cache() const
+{
+    return m_cache.get();
+}
+
+bool AbstractStage::inputHashes(StageCache::Key & hashes) const
 {
-    std::set<AbstractInputSlot*> inputs = allInputs();
+    // Results of stages without inputs or with forced processing depend on more than their inputs
+    if (m_alwaysProcess || m_scheduledManually || m_inputs.empty())
+        return false;
 
-    return m_alwaysProcess || m_processScheduled || inputs.empty() || std::any_of(inputs.begin(), inputs.end(), [](const AbstractInputSlot * input) {
-        return input->hasChanged();
-    });
+    hashes.reserve(m_inputs.size());
+
+    for (const AbstractInputSlot * input : m_inputs)
+    {
+        const AbstractData * data = input->connectedData();
+        size_t hash = 0;
+
+        if (data && !data->contentHash(hash))
+            return false;
+
+        hashes.push_back(hash);
+    }
+
+    return true;
+}
+
+bool AbstractStage::needsToProcess() const
+{
+    return m_dirty || m_alwaysProcess || m_processScheduled;
 }
 
 bool AbstractStage::inputsUsable() const
@@ -94,15 +193,14 @@ bool AbstractStage::inputsUsable() const
     if (m_usable.isValid())
         return m_usable.value();
 
-    std::set<AbstractInputSlot*> inputs = allInputs();
-    m_usable.setValue(std::all_of(inputs.begin(), inputs.end(), [](const AbstractInputSlot * input) {
+    m_usable.setValue(std::all_of(m_inputs.begin(), m_inputs.end(), [](const AbstractInputSlot * input) {
         return input->isUsable();
     }));
 
     if (!m_usable.value())
     {
         std::cout << "Some inputs in " << asPrintable() << " are not connected: ";
-        for (AbstractInputSlot * slot : inputs)
+        for (AbstractInputSlot * slot : m_inputs)
             if (!slot->isUsable())
                 std::cout << slot->asPrintable() << ". ";
         std::cout << std::endl;
@@ -113,15 +211,36 @@ bool AbstractStage::inputsUsable() const
 
 void AbstractStage::markInputsProcessed()
 {
-    for (AbstractInputSlot * input : m_inputs)
+    for (AbstractInputSlot * input : inputs())
     {
         input->processed();
     }
 }
 
+void AbstractStage::markDirty()
+{
+    if (!m_dirty.exchange(true) && m_pipeline)
+    {
+        m_pipeline->scheduleStage(this);
+    }
+}
+
+void AbstractStage::outputsChanged()
+{
+    if (m_pipeline)
+    {
+        m_pipeline->invalidateDataIndex();
+    }
+}
+
+bool AbstractStage::isDirty() const
+{
+    return m_dirty;
+}
+
 void AbstractStage::invalidateOutputs()
 {
-    for (AbstractData * output : m_outputs)
+    for (AbstractData * output : outputs())
     {
         output->invalidate();
     }
@@ -137,9 +256,44 @@ bool AbstractStage::isEnabled() const
     return m_enabled;
 }
 
+void AbstractStage::setRequiresContext(bool requiresContext)
+{
+    m_requiresContext = requiresContext;
+}
+
+bool AbstractStage::requiresContext() const
+{
+    return m_requiresContext;
+}
+
+void AbstractStage::setDeferrable(bool deferrable)
+{
+    m_deferrable = deferrable;
+}
+
+bool AbstractStage::isDeferrable() const
+{
+    return m_deferrable;
+}
+
+void AbstractStage::setPriority(int priority)
+{
+    m_priority = priority;
+}
+
+int AbstractStage::priority() const
+{
+    return m_priority;
+}
+
 void AbstractStage::alwaysProcess(bool on)
 {
     m_alwaysProcess = on;
+
+    if (on)
+    {
+        markDirty();
+    }
 }
 
 bool AbstractStage::isAlwaysProcess() const
@@ -150,11 +304,13 @@ bool AbstractStage::isAlwaysProcess() const
 void AbstractStage::scheduleProcess()
 {
     m_processScheduled = true;
+
+    markDirty();
 }
 
 bool AbstractStage::requires(const AbstractStage * stage, bool recursive) const
 {
-    for (AbstractInputSlot * slot : m_inputs)
+    for (AbstractInputSlot * slot : inputs())
     {
         if (slot->isFeedback() || !slot->connectedData() || !slot->connectedData()->owner())
             continue;
@@ -172,70 +328,75 @@ bool AbstractStage::requires(const AbstractStage * stage, bool recursive) const
     return false;
 }
 
-const std::set<AbstractData*> & AbstractStage::outputs() const
+SlotView<AbstractData*> AbstractStage::outputs() const
 {
-    return m_outputs;
+    return SlotView<AbstractData*>(m_outputs, m_numOwnOutputs);
 }
 
-std::set<AbstractData*> AbstractStage::allOutputs() const
+SlotView<AbstractData*> AbstractStage::allOutputs() const
 {
-    std::set<AbstractData*> outputs;
-
-    std::set_union(
-        m_outputs.begin(),
-        m_outputs.end(),
-        m_sharedOutputs.begin(),
-        m_sharedOutputs.end(),
-        std::inserter(outputs, outputs.end())
-    );
-
-    return outputs;
+    return SlotView<AbstractData*>(m_outputs, m_outputs.size());
 }
 
-const std::set<AbstractInputSlot*> & AbstractStage::inputs() const
+SlotView<AbstractInputSlot*> AbstractStage::inputs() const
 {
-    return m_inputs;
+    return SlotView<AbstractInputSlot*>(m_inputs, m_numOwnInputs);
 }
 
-std::set<AbstractInputSlot*> AbstractStage::allInputs() const
+SlotView<AbstractInputSlot*> AbstractStage::allInputs() const
 {
-    std::set<AbstractInputSlot*> inputs;
-
-    std::set_union(
-        m_inputs.begin(),
-        m_inputs.end(),
-        m_sharedInputs.begin(),
-        m_sharedInputs.end(),
-        std::inserter(inputs, inputs.end())
-    );
-
-    return inputs;
+    return SlotView<AbstractInputSlot*>(m_inputs, m_inputs.size());
 }
 
 void AbstractStage::addOutput(const std::string & name, AbstractData & output)
 {
     output.setName(name);
     output.setOwner(this);
-    m_outputs.insert(&output);
+
+    if (!outputs().contains(&output))
+    {
+        // Own outputs precede shared ones, so their indices are not affected by sharing
+        m_outputs.insert(m_outputs.begin() + m_numOwnOutputs, &output);
+        ++m_numOwnOutputs;
+
+        if (output.hasHistory())
+            m_historyOutputs.push_back(&output);
+    }
+
+    outputsChanged();
 }
 
 void AbstractStage::shareOutput(AbstractData* output)
 {
-    m_sharedOutputs.insert(output);
+    if (!allOutputs().contains(output))
+    {
+        m_outputs.push_back(output);
+    }
+
+    outputsChanged();
 }
 
 void AbstractStage::addInput(const std::string & name, AbstractInputSlot & input)
 {
     input.setName(name);
     input.setOwner(this);
-    m_inputs.insert(&input);
+
+    if (!inputs().contains(&input))
+    {
+        m_inputs.insert(m_inputs.begin() + m_numOwnInputs, &input);
+        ++m_numOwnInputs;
+    }
 
     input.connectionChanged.connect(dependenciesChanged);
 }
 
 void AbstractStage::shareInput(AbstractInputSlot * input)
 {
-    m_sharedInputs.insert(input);
+    if (!allInputs().contains(input))
+    {
+        m_inputs.push_back(input);
+        input->m_sharingStages.push_back(this);
+    }
 
     input->connectionChanged.connect(dependenciesChanged);
 }
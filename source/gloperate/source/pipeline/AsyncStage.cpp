@@ -0,0 +1,87 @@
+
+#include <gloperate/pipeline/AsyncStage.h>
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+
+#include <gloperate/base/ThreadPool.h>
+
+
+namespace gloperate
+{
+
+
+AsyncStage::AsyncStage(const std::string & name)
+: AbstractStage(name)
+, m_restartPending(false)
+{
+}
+
+AsyncStage::~AsyncStage()
+{
+    wait();
+}
+
+bool AsyncStage::isProcessing() const
+{
+    return m_result.valid() && m_result.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+void AsyncStage::wait() const
+{
+    if (m_result.valid())
+        m_result.wait();
+}
+
+bool AsyncStage::publish()
+{
+    if (!m_result.valid() || isProcessing())
+        return false;
+
+    try
+    {
+        m_result.get();
+    }
+    catch (const std::exception & e)
+    {
+        std::cerr << "Processing " << asPrintable() << " failed: " << e.what() << std::endl;
+    }
+
+    for (auto & swap : m_swaps)
+    {
+        swap();
+    }
+
+    if (m_restartPending)
+    {
+        m_restartPending = false;
+        markDirty();
+    }
+
+    return true;
+}
+
+void AsyncStage::prepare()
+{
+}
+
+void AsyncStage::process()
+{
+    // Only one job at a time, the stage is processed again once the results are published
+    if (m_result.valid())
+    {
+        m_restartPending = true;
+        return;
+    }
+
+    if (!m_worker)
+        m_worker.reset(new ThreadPool(1));
+
+    prepare();
+
+    m_result = m_worker->submit([this]() { processAsync(); });
+}
+
+
+} // namespace gloperate
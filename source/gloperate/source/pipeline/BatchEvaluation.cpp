@@ -0,0 +1,288 @@
+
+#include <gloperate/pipeline/BatchEvaluation.h>
+
+#include <algorithm>
+#include <future>
+#include <iostream>
+#include <iterator>
+#include <set>
+
+#include <gloperate/base/ThreadPool.h>
+
+#include <gloperate/pipeline/AbstractData.h>
+#include <gloperate/pipeline/AbstractPipeline.h>
+#include <gloperate/pipeline/AbstractStage.h>
+
+
+namespace
+{
+
+
+bool sameContent(const gloperate::AbstractData & lhs, const gloperate::AbstractData & rhs)
+{
+    size_t lhsHash = 0;
+    size_t rhsHash = 0;
+
+    return lhs.contentHash(lhsHash) && rhs.contentHash(rhsHash) && lhsHash == rhsHash;
+}
+
+
+} // namespace
+
+
+namespace gloperate
+{
+
+
+const std::map<std::string, std::shared_ptr<AbstractData>> & BatchEvaluation::Parameters::values() const
+{
+    return m_values;
+}
+
+const AbstractData * BatchEvaluation::Outputs::output(const std::string & name) const
+{
+    const auto it = m_values.find(name);
+
+    return it != m_values.end() ? it->second.get() : nullptr;
+}
+
+void BatchEvaluation::Outputs::set(const std::string & name, const std::shared_ptr<AbstractData> & value)
+{
+    m_values[name] = value;
+}
+
+
+BatchEvaluation::BatchEvaluation(const std::vector<std::string> & outputNames)
+: m_outputNames(outputNames)
+{
+}
+
+BatchEvaluation::~BatchEvaluation()
+{
+}
+
+const std::vector<std::string> & BatchEvaluation::outputNames() const
+{
+    return m_outputNames;
+}
+
+std::vector<BatchEvaluation::Outputs> BatchEvaluation::run(AbstractPipeline & pipeline, const std::vector<Parameters> & variants) const
+{
+    std::vector<Outputs> results(variants.size());
+
+    run(pipeline, variants, order(variants), results);
+
+    return results;
+}
+
+std::vector<BatchEvaluation::Outputs> BatchEvaluation::run(const std::vector<AbstractPipeline *> & pipelines, const std::vector<Parameters> & variants) const
+{
+    std::vector<Outputs> results(variants.size());
+
+    if (pipelines.empty())
+        return results;
+
+    const auto indices = order(variants);
+
+    const bool requiresContext = std::any_of(pipelines.begin(), pipelines.end(), [](const AbstractPipeline * pipeline)
+    {
+        return std::any_of(pipeline->stages().begin(), pipeline->stages().end(), [](const AbstractStage * stage) { return stage->requiresContext(); });
+    });
+
+    if (pipelines.size() == 1 || requiresContext)
+    {
+        run(*pipelines.front(), variants, indices, results);
+        return results;
+    }
+
+    // Contiguous ranges keep similar variants on the same pipeline
+    const size_t numPipelines = std::min(pipelines.size(), std::max<size_t>(indices.size(), 1));
+    const size_t rangeSize = (indices.size() + numPipelines - 1) / numPipelines;
+
+    ThreadPool threadPool(static_cast<unsigned int>(numPipelines));
+    std::vector<std::future<void>> futures;
+
+    for (size_t i = 0; i < numPipelines; ++i)
+    {
+        const auto first = indices.begin() + std::min(i * rangeSize, indices.size());
+        const auto last = indices.begin() + std::min((i + 1) * rangeSize, indices.size());
+        const std::vector<size_t> range(first, last);
+
+        AbstractPipeline * pipeline = pipelines[i];
+
+        // Each range writes to distinct results
+        futures.push_back(threadPool.submit([this, pipeline, &variants, range, &results]()
+        {
+            run(*pipeline, variants, range, results);
+        }));
+    }
+
+    for (auto & future : futures)
+    {
+        future.get();
+    }
+
+    return results;
+}
+
+std::vector<size_t> BatchEvaluation::order(const std::vector<Parameters> & variants) const
+{
+    std::set<std::string> names;
+
+    for (const auto & variant : variants)
+    {
+        for (const auto & value : variant.values())
+        {
+            names.insert(value.first);
+        }
+    }
+
+    // Variants are sorted by the hashes of their values, unhashable values keep their order
+    std::vector<std::vector<size_t>> keys(variants.size());
+
+    for (size_t i = 0; i < variants.size(); ++i)
+    {
+        const auto & values = variants[i].values();
+
+        for (const auto & name : names)
+        {
+            const auto it = values.find(name);
+            size_t hash = 0;
+
+            if (it != values.end())
+                it->second->contentHash(hash);
+
+            keys[i].push_back(hash);
+        }
+    }
+
+    std::vector<size_t> indices(variants.size());
+
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        indices[i] = i;
+    }
+
+    std::stable_sort(indices.begin(), indices.end(), [&keys](size_t lhs, size_t rhs) { return keys[lhs] < keys[rhs]; });
+
+    return indices;
+}
+
+void BatchEvaluation::run(AbstractPipeline & pipeline, const std::vector<Parameters> & variants,
+    const std::vector<size_t> & indices, std::vector<Outputs> & results) const
+{
+    if (!pipeline.isInitialized())
+    {
+        pipeline.initialize();
+    }
+
+    std::vector<AbstractData *> outputs;
+
+    for (const auto & name : m_outputNames)
+    {
+        const auto candidates = pipeline.findOutputs(name);
+
+        if (candidates.empty())
+        {
+            std::cerr << "Output " << name << " not found in " << pipeline.asPrintable() << std::endl;
+            outputs.push_back(nullptr);
+            continue;
+        }
+
+        // Results are copies, which need a content hash (see Data)
+        if (!candidates.front()->canSnapshot())
+        {
+            std::cerr << "Cannot evaluate output " << name << " in a batch: value cannot be copied" << std::endl;
+            outputs.push_back(nullptr);
+            continue;
+        }
+
+        outputs.push_back(candidates.front());
+    }
+
+    std::vector<AbstractData *> evaluatedOutputs;
+    std::copy_if(outputs.begin(), outputs.end(), std::back_inserter(evaluatedOutputs), [](AbstractData * output) { return output != nullptr; });
+
+    // Parameters assigned by any variant are reset for variants that do not assign them, and afterwards
+    std::map<std::string, AbstractData *> parameters;
+    std::map<AbstractData *, std::shared_ptr<AbstractData>> previousValues;
+
+    for (auto index : indices)
+    {
+        for (const auto & value : variants[index].values())
+        {
+            if (parameters.count(value.first) > 0)
+                continue;
+
+            AbstractData * parameter = pipeline.findParameter(value.first);
+            parameters[value.first] = parameter;
+
+            if (!parameter)
+            {
+                std::cerr << "Parameter " << value.first << " not found in " << pipeline.asPrintable() << std::endl;
+                continue;
+            }
+
+            if (previousValues.count(parameter) > 0)
+                continue;
+
+            previousValues[parameter] = parameter->snapshot();
+
+            if (!previousValues[parameter])
+            {
+                std::cerr << "Cannot reset parameter " << value.first << ": value cannot be copied" << std::endl;
+            }
+        }
+    }
+
+    for (auto index : indices)
+    {
+        std::set<AbstractData *> assigned;
+
+        for (const auto & value : variants[index].values())
+        {
+            AbstractData * parameter = parameters[value.first];
+
+            if (!parameter)
+                continue;
+
+            assigned.insert(parameter);
+
+            // Keeping equal values avoids processing dependent stages again
+            if (sameContent(*parameter, *value.second))
+                continue;
+
+            if (!parameter->restore(*value.second))
+            {
+                std::cerr << "Cannot assign parameter " << value.first << ": type mismatch or value cannot be copied" << std::endl;
+            }
+        }
+
+        // Results must not depend on the variants evaluated before
+        for (const auto & previousValue : previousValues)
+        {
+            if (!previousValue.second || assigned.count(previousValue.first) > 0)
+                continue;
+
+            if (!sameContent(*previousValue.first, *previousValue.second))
+                previousValue.first->restore(*previousValue.second);
+        }
+
+        pipeline.evaluate(evaluatedOutputs);
+
+        for (size_t i = 0; i < outputs.size(); ++i)
+        {
+            if (outputs[i])
+                results[index].set(m_outputNames[i], outputs[i]->snapshot());
+        }
+    }
+
+    for (const auto & previousValue : previousValues)
+    {
+        if (previousValue.second)
+            previousValue.first->restore(*previousValue.second);
+    }
+}
+
+
+} // namespace gloperate
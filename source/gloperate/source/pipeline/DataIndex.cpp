@@ -0,0 +1,71 @@
+
+#include <gloperate/pipeline/DataIndex.h>
+
+#include <gloperate/pipeline/AbstractData.h>
+
+
+namespace
+{
+    const std::vector<gloperate::AbstractData *> noData;
+}
+
+
+namespace gloperate
+{
+
+
+DataIndex::DataIndex()
+{
+}
+
+DataIndex::~DataIndex()
+{
+}
+
+void DataIndex::add(AbstractData * data)
+{
+    m_names[data->name()].push_back(data);
+
+    const std::string qualifiedName = data->qualifiedName();
+
+    if (qualifiedName != data->name())
+    {
+        m_names[qualifiedName].push_back(data);
+    }
+
+    m_types[data->typeId()].push_back(data);
+}
+
+void DataIndex::clear()
+{
+    m_names.clear();
+    m_types.clear();
+}
+
+const std::vector<AbstractData *> & DataIndex::find(const std::string & name) const
+{
+    const auto it = m_names.find(name);
+
+    return it != m_names.end() ? it->second : noData;
+}
+
+AbstractData * DataIndex::find(const std::string & name, size_t typeId) const
+{
+    for (AbstractData * data : find(name))
+    {
+        if (data->typeId() == typeId)
+            return data;
+    }
+
+    return nullptr;
+}
+
+AbstractData * DataIndex::findType(size_t typeId) const
+{
+    const auto it = m_types.find(typeId);
+
+    return it != m_types.end() ? it->second.front() : nullptr;
+}
+
+
+} // namespace gloperate
@@ -0,0 +1,95 @@
+
+#include <gloperate/pipeline/DataSize.h>
+
+#include <algorithm>
+
+#include <glbinding/gl/enum.h>
+
+#include <globjects/base/ref_ptr.h>
+#include <globjects/Buffer.h>
+#include <globjects/Texture.h>
+
+
+namespace
+{
+
+
+// Mipmap levels are queried until a level has no texels
+const gl::GLint maxTextureLevels = 32;
+
+
+size_t levelSizeInBytes(const globjects::Texture & texture, gl::GLint level)
+{
+    const size_t width = std::max(texture.getLevelParameter(level, gl::GL_TEXTURE_WIDTH), 0);
+    const size_t height = std::max(texture.getLevelParameter(level, gl::GL_TEXTURE_HEIGHT), 1);
+    const size_t depth = std::max(texture.getLevelParameter(level, gl::GL_TEXTURE_DEPTH), 1);
+
+    if (width == 0)
+        return 0;
+
+    if (texture.getLevelParameter(level, gl::GL_TEXTURE_COMPRESSED) != 0)
+        return static_cast<size_t>(texture.getLevelParameter(level, gl::GL_TEXTURE_COMPRESSED_IMAGE_SIZE));
+
+    // Component sizes are given in bits and do not depend on the format enum
+    const gl::GLenum componentSizes[] = {
+        gl::GL_TEXTURE_RED_SIZE, gl::GL_TEXTURE_GREEN_SIZE, gl::GL_TEXTURE_BLUE_SIZE, gl::GL_TEXTURE_ALPHA_SIZE,
+        gl::GL_TEXTURE_DEPTH_SIZE, gl::GL_TEXTURE_STENCIL_SIZE, gl::GL_TEXTURE_SHARED_SIZE };
+
+    size_t bitsPerTexel = 0;
+
+    for (const gl::GLenum componentSize : componentSizes)
+    {
+        bitsPerTexel += static_cast<size_t>(std::max(texture.getLevelParameter(level, componentSize), 0));
+    }
+
+    return width * height * depth * ((bitsPerTexel + 7) / 8);
+}
+
+
+} // namespace
+
+
+namespace gloperate
+{
+
+
+size_t DataSize<globjects::Texture *>::sizeInBytes(const globjects::Texture * texture)
+{
+    if (!texture)
+        return sizeof(texture);
+
+    size_t size = sizeof(texture);
+
+    for (gl::GLint level = 0; level < maxTextureLevels; ++level)
+    {
+        const size_t levelSize = levelSizeInBytes(*texture, level);
+
+        if (levelSize == 0)
+            break;
+
+        size += levelSize;
+    }
+
+    return size;
+}
+
+size_t DataSize<globjects::ref_ptr<globjects::Texture>>::sizeInBytes(const globjects::ref_ptr<globjects::Texture> & texture)
+{
+    return DataSize<globjects::Texture *>::sizeInBytes(texture.get());
+}
+
+size_t DataSize<globjects::Buffer *>::sizeInBytes(const globjects::Buffer * buffer)
+{
+    if (!buffer)
+        return sizeof(buffer);
+
+    return sizeof(buffer) + static_cast<size_t>(std::max(buffer->getParameter(gl::GL_BUFFER_SIZE), 0));
+}
+
+size_t DataSize<globjects::ref_ptr<globjects::Buffer>>::sizeInBytes(const globjects::ref_ptr<globjects::Buffer> & buffer)
+{
+    return DataSize<globjects::Buffer *>::sizeInBytes(buffer.get());
+}
+
+
+} // namespace gloperate
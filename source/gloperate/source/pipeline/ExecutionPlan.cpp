@@ -0,0 +1,137 @@
+
+#include <gloperate/pipeline/ExecutionPlan.h>
+
+#include <algorithm>
+#include <limits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <gloperate/pipeline/AbstractStage.h>
+
+
+namespace
+{
+
+
+const size_t bitsPerWord = 64;
+
+
+size_t lowestBit(std::uint64_t word)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index = 0;
+    _BitScanForward64(&index, word);
+    return index;
+#elif defined(__GNUC__)
+    return static_cast<size_t>(__builtin_ctzll(word));
+#else
+    size_t index = 0;
+
+    while ((word & 1u) == 0)
+    {
+        word >>= 1;
+        ++index;
+    }
+
+    return index;
+#endif
+}
+
+
+} // namespace
+
+
+namespace gloperate
+{
+
+
+const size_t ExecutionPlan::npos = std::numeric_limits<size_t>::max();
+
+
+ExecutionPlan::ExecutionPlan(const std::vector<AbstractStage *> & stages)
+: m_scheduled((stages.size() + bitsPerWord - 1) / bitsPerWord, 0)
+{
+    m_steps.reserve(stages.size());
+
+    for (auto stage : stages)
+    {
+        Step step;
+        step.stage = stage;
+        step.usable = stage->inputsUsable();
+
+        m_steps.push_back(step);
+    }
+
+    reschedule();
+}
+
+ExecutionPlan::~ExecutionPlan()
+{
+}
+
+size_t ExecutionPlan::size() const
+{
+    return m_steps.size();
+}
+
+AbstractStage * ExecutionPlan::stage(size_t index) const
+{
+    return m_steps[index].stage;
+}
+
+bool ExecutionPlan::isUsable(size_t index) const
+{
+    return m_steps[index].usable;
+}
+
+void ExecutionPlan::schedule(size_t index)
+{
+    m_scheduled[index / bitsPerWord] |= std::uint64_t(1) << (index % bitsPerWord);
+}
+
+void ExecutionPlan::unschedule(size_t index)
+{
+    m_scheduled[index / bitsPerWord] &= ~(std::uint64_t(1) << (index % bitsPerWord));
+}
+
+bool ExecutionPlan::isScheduled(size_t index) const
+{
+    return (m_scheduled[index / bitsPerWord] & (std::uint64_t(1) << (index % bitsPerWord))) != 0;
+}
+
+void ExecutionPlan::reschedule()
+{
+    std::fill(m_scheduled.begin(), m_scheduled.end(), 0);
+
+    for (size_t i = 0; i < m_steps.size(); ++i)
+    {
+        if (m_steps[i].stage->isDirty())
+            schedule(i);
+    }
+}
+
+size_t ExecutionPlan::nextScheduled(size_t index) const
+{
+    size_t word = index / bitsPerWord;
+
+    if (word >= m_scheduled.size())
+        return npos;
+
+    // Ignore the bits before the start position
+    std::uint64_t bits = m_scheduled[word] & (~std::uint64_t(0) << (index % bitsPerWord));
+
+    while (bits == 0)
+    {
+        if (++word == m_scheduled.size())
+            return npos;
+
+        bits = m_scheduled[word];
+    }
+
+    return word * bitsPerWord + lowestBit(bits);
+}
+
+
+} // namespace gloperate
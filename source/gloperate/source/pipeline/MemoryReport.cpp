@@ -0,0 +1,105 @@
+
+#include <gloperate/pipeline/MemoryReport.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+
+
+namespace
+{
+
+
+double toKibibytes(size_t bytes)
+{
+    return static_cast<double>(bytes) / 1024.0;
+}
+
+
+} // namespace
+
+
+namespace gloperate
+{
+
+
+MemoryReport::MemoryReport()
+: totalBytes(0)
+, peakBytes(0)
+{
+}
+
+void MemoryReport::writeSummary(std::ostream & stream) const
+{
+    std::vector<Stage> stages = this->stages;
+
+    std::stable_sort(stages.begin(), stages.end(), [](const Stage & lhs, const Stage & rhs)
+    {
+        return lhs.bytes > rhs.bytes;
+    });
+
+    size_t nameWidth = 5;
+
+    for (const Item & parameter : parameters)
+    {
+        nameWidth = std::max(nameWidth, parameter.name.size());
+    }
+
+    for (const Stage & stage : stages)
+    {
+        nameWidth = std::max(nameWidth, stage.name.size());
+
+        for (const Item & output : stage.outputs)
+        {
+            nameWidth = std::max(nameWidth, output.name.size() + 2);
+        }
+    }
+
+    const auto flags = stream.flags();
+    const auto precision = stream.precision();
+
+    stream << std::left << std::setw(nameWidth) << "Data" << std::right
+           << std::setw(14) << "Size [KiB]"
+           << std::setw(14) << "Peak [KiB]"
+           << std::setw(14) << "Cache [KiB]" << std::endl;
+
+    stream << std::fixed << std::setprecision(1);
+
+    const auto writeItem = [&stream, nameWidth](const Item & item, const std::string & indent)
+    {
+        stream << std::left << std::setw(nameWidth) << (indent + item.name) << std::right
+               << std::setw(14) << toKibibytes(item.bytes)
+               << std::setw(14) << toKibibytes(item.peakBytes)
+               << std::setw(14) << ""
+               << (item.connected ? "" : "  (unused)") << std::endl;
+    };
+
+    for (const Item & parameter : parameters)
+    {
+        writeItem(parameter, "");
+    }
+
+    for (const Stage & stage : stages)
+    {
+        stream << std::left << std::setw(nameWidth) << stage.name << std::right
+               << std::setw(14) << toKibibytes(stage.bytes)
+               << std::setw(14) << toKibibytes(stage.peakBytes)
+               << std::setw(14) << toKibibytes(stage.cacheBytes)
+               << (stage.enabled ? "" : "  (disabled)") << std::endl;
+
+        for (const Item & output : stage.outputs)
+        {
+            writeItem(output, "  ");
+        }
+    }
+
+    stream << std::left << std::setw(nameWidth) << "Total" << std::right
+           << std::setw(14) << toKibibytes(totalBytes)
+           << std::setw(14) << toKibibytes(peakBytes) << std::endl;
+
+    stream.flags(flags);
+    stream.precision(precision);
+}
+
+
+} // namespace gloperate
@@ -0,0 +1,95 @@
+
+#include <gloperate/pipeline/MemoryTracker.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <gloperate/pipeline/AbstractData.h>
+#include <gloperate/pipeline/AbstractStage.h>
+
+
+namespace gloperate
+{
+
+
+MemoryTracker::MemoryTracker()
+: m_totalBytes(0)
+, m_peakBytes(0)
+{
+}
+
+MemoryTracker::~MemoryTracker()
+{
+}
+
+void MemoryTracker::recordStage(const AbstractStage & stage)
+{
+    // Sizes are measured outside of the lock, as they may query OpenGL
+    std::vector<std::pair<const AbstractData *, size_t>> outputSizes;
+    size_t stageSize = stage.cache() ? stage.cache()->sizeInBytes() : 0;
+
+    for (const AbstractData * output : stage.outputs())
+    {
+        const size_t size = output->sizeInBytes();
+
+        outputSizes.emplace_back(output, size);
+        stageSize += size;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (const auto & outputSize : outputSizes)
+    {
+        size_t & peak = m_dataPeaks[outputSize.first];
+        peak = std::max(peak, outputSize.second);
+    }
+
+    size_t & peak = m_stagePeaks[&stage];
+    peak = std::max(peak, stageSize);
+
+    size_t & previousSize = m_stageSizes[&stage];
+    m_totalBytes = m_totalBytes - previousSize + stageSize;
+    previousSize = stageSize;
+
+    m_peakBytes = std::max(m_peakBytes, m_totalBytes);
+}
+
+size_t MemoryTracker::peakBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_peakBytes;
+}
+
+size_t MemoryTracker::peakBytes(const AbstractStage * stage) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto it = m_stagePeaks.find(stage);
+
+    return it != m_stagePeaks.end() ? it->second : 0;
+}
+
+size_t MemoryTracker::peakBytes(const AbstractData * data) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto it = m_dataPeaks.find(data);
+
+    return it != m_dataPeaks.end() ? it->second : 0;
+}
+
+void MemoryTracker::reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_dataPeaks.clear();
+    m_stagePeaks.clear();
+    m_stageSizes.clear();
+    m_totalBytes = 0;
+    m_peakBytes = 0;
+}
+
+
+} // namespace gloperate
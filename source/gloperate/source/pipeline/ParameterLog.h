@@ -0,0 +1,99 @@
+#pragma once
+
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+
+
+namespace gloperate
+{
+namespace parameterlog
+{
+
+
+/**
+*  @brief
+*    Binary format of parameter logs
+*
+*    A log starts with the magic bytes and the format version,
+*    followed by records. Each record starts with its type:
+*
+*      Parameter  <index> <name>   Declares the name of a parameter index
+*      Change     <index> <value>  New value of a parameter (as string)
+*      Frame      <delta>          Frame boundary, nanoseconds since the previous one
+*
+*    Integers are encoded as LEB128 varints, strings by their length
+*    followed by their characters.
+*/
+const char magic[] = { 'G', 'L', 'P', 'L' };
+const std::uint64_t version = 1;
+const std::uint64_t maxStringSize = 1 << 26;
+const std::uint64_t maxParameterIndex = 1 << 16;    /**< Larger indices are treated as corrupt */
+
+enum class RecordType : std::uint8_t
+{
+    Parameter = 1,
+    Change = 2,
+    Frame = 3
+};
+
+
+inline void writeVarint(std::ostream & stream, std::uint64_t value)
+{
+    do
+    {
+        auto byte = static_cast<std::uint8_t>(value & 0x7f);
+        value >>= 7;
+
+        if (value != 0)
+            byte |= 0x80;
+
+        stream.put(static_cast<char>(byte));
+    }
+    while (value != 0);
+}
+
+inline bool readVarint(std::istream & stream, std::uint64_t & value)
+{
+    value = 0;
+
+    for (unsigned int shift = 0; shift < 64; shift += 7)
+    {
+        const auto character = stream.get();
+
+        if (character == std::istream::traits_type::eof())
+            return false;
+
+        value |= static_cast<std::uint64_t>(character & 0x7f) << shift;
+
+        if ((character & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+inline void writeString(std::ostream & stream, const std::string & string)
+{
+    writeVarint(stream, string.size());
+    stream.write(string.data(), static_cast<std::streamsize>(string.size()));
+}
+
+inline bool readString(std::istream & stream, std::string & string)
+{
+    std::uint64_t size = 0;
+
+    // Sizes beyond the limit indicate a corrupted log
+    if (!readVarint(stream, size) || size > maxStringSize)
+        return false;
+
+    string.resize(static_cast<size_t>(size));
+
+    return size == 0 || static_cast<bool>(stream.read(&string[0], static_cast<std::streamsize>(size)));
+}
+
+
+} // namespace parameterlog
+} // namespace gloperate
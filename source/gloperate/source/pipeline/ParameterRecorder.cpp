@@ -0,0 +1,155 @@
+
+#include <gloperate/pipeline/ParameterRecorder.h>
+
+#include <ostream>
+
+#include <reflectionzeug/property/AbstractValueProperty.h>
+
+#include <gloperate/pipeline/AbstractData.h>
+
+#include "ParameterLog.h"
+
+
+namespace gloperate
+{
+
+
+ParameterRecorder::ParameterRecorder(std::ostream & stream)
+: m_stream(stream)
+, m_headerWritten(false)
+, m_recording(false)
+, m_timer(false)
+, m_lastFrame(ChronoTimer::Duration::zero())
+, m_frames(0)
+, m_changes(0)
+{
+}
+
+ParameterRecorder::~ParameterRecorder()
+{
+    stop();
+
+    for (Parameter & parameter : m_parameters)
+    {
+        parameter.connection.disconnect();
+    }
+}
+
+void ParameterRecorder::addParameter(const std::string & name, AbstractData & data, reflectionzeug::AbstractValueProperty & property)
+{
+    addParameter(name, data, &property, nullptr);
+}
+
+void ParameterRecorder::addParameter(const std::string & name, AbstractData & data, reflectionzeug::AbstractValueProperty * property,
+    const std::shared_ptr<reflectionzeug::AbstractValueProperty> & ownedProperty)
+{
+    const size_t index = m_parameters.size();
+
+    Parameter parameter;
+    parameter.name = name;
+    parameter.data = &data;
+    parameter.property = property;
+    parameter.ownedProperty = ownedProperty;
+    parameter.connection = data.invalidated.connect([this, index]()
+    {
+        if (m_recording)
+            recordChange(index);
+    });
+
+    m_parameters.push_back(parameter);
+
+    if (m_recording)
+    {
+        declare(index);
+        recordChange(index);
+    }
+}
+
+void ParameterRecorder::start()
+{
+    if (m_recording)
+        return;
+
+    // Restarting continues the same log
+    if (!m_headerWritten)
+    {
+        m_stream.write(parameterlog::magic, sizeof(parameterlog::magic));
+        parameterlog::writeVarint(m_stream, parameterlog::version);
+
+        m_headerWritten = true;
+    }
+
+    m_recording = true;
+    m_frames = 0;
+    m_changes = 0;
+    m_lastFrame = ChronoTimer::Duration::zero();
+
+    m_timer.reset();
+    m_timer.start();
+
+    // Initial values
+    for (size_t i = 0; i < m_parameters.size(); ++i)
+    {
+        declare(i);
+        recordChange(i);
+    }
+}
+
+void ParameterRecorder::stop()
+{
+    if (!m_recording)
+        return;
+
+    m_recording = false;
+    m_timer.pause();
+
+    m_stream.flush();
+}
+
+bool ParameterRecorder::isRecording() const
+{
+    return m_recording;
+}
+
+void ParameterRecorder::frame()
+{
+    if (!m_recording)
+        return;
+
+    const auto time = m_timer.elapsed();
+
+    m_stream.put(static_cast<char>(parameterlog::RecordType::Frame));
+    parameterlog::writeVarint(m_stream, static_cast<std::uint64_t>((time - m_lastFrame).count()));
+
+    m_lastFrame = time;
+    ++m_frames;
+}
+
+size_t ParameterRecorder::frames() const
+{
+    return m_frames;
+}
+
+size_t ParameterRecorder::changes() const
+{
+    return m_changes;
+}
+
+void ParameterRecorder::declare(size_t index)
+{
+    m_stream.put(static_cast<char>(parameterlog::RecordType::Parameter));
+    parameterlog::writeVarint(m_stream, index);
+    parameterlog::writeString(m_stream, m_parameters[index].name);
+}
+
+void ParameterRecorder::recordChange(size_t index)
+{
+    m_stream.put(static_cast<char>(parameterlog::RecordType::Change));
+    parameterlog::writeVarint(m_stream, index);
+    parameterlog::writeString(m_stream, m_parameters[index].property->toString());
+
+    ++m_changes;
+}
+
+
+} // namespace gloperate
@@ -0,0 +1,195 @@
+
+#include <gloperate/pipeline/ParameterReplayer.h>
+
+#include <algorithm>
+#include <istream>
+#include <thread>
+
+#include <reflectionzeug/property/AbstractValueProperty.h>
+
+#include <gloperate/pipeline/AbstractPipeline.h>
+
+#include "ParameterLog.h"
+
+
+namespace gloperate
+{
+
+
+ParameterReplayer::ParameterReplayer(std::istream & stream)
+: m_stream(stream)
+, m_valid(false)
+, m_atEnd(true)
+, m_timing(Timing::FullSpeed)
+, m_started(false)
+, m_timer(false)
+, m_frameTime(ChronoTimer::Duration::zero())
+, m_frames(0)
+, m_changes(0)
+, m_skippedChanges(0)
+{
+    char magic[sizeof(parameterlog::magic)];
+    std::uint64_t version = 0;
+
+    m_valid = m_stream.read(magic, sizeof(magic))
+        && std::equal(magic, magic + sizeof(magic), parameterlog::magic)
+        && parameterlog::readVarint(m_stream, version)
+        && version == parameterlog::version;
+
+    m_atEnd = !m_valid;
+}
+
+ParameterReplayer::~ParameterReplayer()
+{
+}
+
+void ParameterReplayer::addParameter(const std::string & name, reflectionzeug::AbstractValueProperty & property)
+{
+    addParameter(name, &property, nullptr);
+}
+
+void ParameterReplayer::addParameter(const std::string & name, reflectionzeug::AbstractValueProperty * property,
+    const std::shared_ptr<reflectionzeug::AbstractValueProperty> & ownedProperty)
+{
+    m_properties[name] = property;
+
+    if (ownedProperty)
+        m_ownedProperties.push_back(ownedProperty);
+}
+
+ParameterReplayer::Timing ParameterReplayer::timing() const
+{
+    return m_timing;
+}
+
+void ParameterReplayer::setTiming(Timing timing)
+{
+    m_timing = timing;
+}
+
+bool ParameterReplayer::isValid() const
+{
+    return m_valid;
+}
+
+bool ParameterReplayer::atEnd() const
+{
+    return m_atEnd;
+}
+
+bool ParameterReplayer::nextFrame()
+{
+    if (m_atEnd)
+        return false;
+
+    // Original timing is relative to the first replayed frame
+    if (!m_started)
+    {
+        m_started = true;
+        m_timer.reset();
+        m_timer.start();
+    }
+
+    std::string value;
+
+    while (true)
+    {
+        const auto type = m_stream.get();
+        std::uint64_t index = 0;
+        std::uint64_t delta = 0;
+
+        if (type == std::istream::traits_type::eof())
+            break;
+
+        switch (static_cast<parameterlog::RecordType>(type))
+        {
+        case parameterlog::RecordType::Parameter:
+            if (!parameterlog::readVarint(m_stream, index) || index > parameterlog::maxParameterIndex || !parameterlog::readString(m_stream, value))
+                break;
+
+            if (index >= m_names.size())
+                m_names.resize(static_cast<size_t>(index) + 1);
+
+            m_names[static_cast<size_t>(index)] = value;
+            continue;
+
+        case parameterlog::RecordType::Change:
+            if (!parameterlog::readVarint(m_stream, index) || !parameterlog::readString(m_stream, value))
+                break;
+
+            applyChange(static_cast<size_t>(index), value);
+            continue;
+
+        case parameterlog::RecordType::Frame:
+            if (!parameterlog::readVarint(m_stream, delta))
+                break;
+
+            m_frameTime += ChronoTimer::Duration(static_cast<ChronoTimer::Duration::rep>(delta));
+            ++m_frames;
+
+            if (m_timing == Timing::Original)
+                waitUntil(m_frameTime);
+
+            return true;
+        }
+
+        // Unknown record or truncated log
+        break;
+    }
+
+    m_atEnd = true;
+
+    return false;
+}
+
+size_t ParameterReplayer::replay(AbstractPipeline & pipeline)
+{
+    size_t frames = 0;
+
+    while (nextFrame())
+    {
+        pipeline.execute();
+        ++frames;
+    }
+
+    return frames;
+}
+
+size_t ParameterReplayer::frames() const
+{
+    return m_frames;
+}
+
+size_t ParameterReplayer::changes() const
+{
+    return m_changes;
+}
+
+size_t ParameterReplayer::skippedChanges() const
+{
+    return m_skippedChanges;
+}
+
+void ParameterReplayer::applyChange(size_t index, const std::string & value)
+{
+    const auto it = index < m_names.size() ? m_properties.find(m_names[index]) : m_properties.end();
+
+    if (it == m_properties.end() || !it->second->fromString(value))
+    {
+        ++m_skippedChanges;
+        return;
+    }
+
+    ++m_changes;
+}
+
+void ParameterReplayer::waitUntil(ChronoTimer::Duration time)
+{
+    const auto elapsed = m_timer.elapsed();
+
+    if (time > elapsed)
+        std::this_thread::sleep_for(time - elapsed);
+}
+
+
+} // namespace gloperate
@@ -0,0 +1,546 @@
+
+#include <gloperate/pipeline/PipelineAnalysis.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <queue>
+#include <string>
+#include <utility>
+
+#include <gloperate/pipeline/AbstractData.h>
+#include <gloperate/pipeline/AbstractInputSlot.h>
+#include <gloperate/pipeline/AbstractPipeline.h>
+#include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/StageProfiler.h>
+
+
+namespace
+{
+
+
+const size_t bitsPerWord = 64;
+
+
+size_t countBits(std::uint64_t word)
+{
+    size_t count = 0;
+
+    while (word != 0)
+    {
+        word &= word - 1;
+        ++count;
+    }
+
+    return count;
+}
+
+double toMilliseconds(gloperate::PipelineAnalysis::Duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+std::string escapeDot(const std::string & str)
+{
+    std::string escaped;
+    escaped.reserve(str.size());
+
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+
+        escaped += c;
+    }
+
+    return escaped;
+}
+
+std::unordered_map<const gloperate::AbstractStage *, gloperate::PipelineAnalysis::Duration> measuredTimes(const gloperate::AbstractPipeline & pipeline)
+{
+    std::unordered_map<const gloperate::AbstractStage *, gloperate::PipelineAnalysis::Duration> times;
+
+    const gloperate::StageProfiler * profiler = pipeline.profiler();
+
+    if (!profiler)
+        return times;
+
+    for (auto stage : pipeline.stages())
+    {
+        times[stage] = profiler->meanTime(stage);
+    }
+
+    return times;
+}
+
+
+} // namespace
+
+
+namespace gloperate
+{
+
+
+PipelineAnalysis::Duration PipelineAnalysis::StageInfo::slack() const
+{
+    return latestStart - earliestStart;
+}
+
+bool PipelineAnalysis::StageInfo::isCritical() const
+{
+    return latestStart == earliestStart;
+}
+
+
+PipelineAnalysis::PipelineAnalysis(const AbstractPipeline & pipeline)
+: m_valid(false)
+, m_work(Duration::zero())
+, m_criticalPathLength(Duration::zero())
+{
+    analyze(pipeline, measuredTimes(pipeline));
+}
+
+PipelineAnalysis::PipelineAnalysis(const AbstractPipeline & pipeline, const std::unordered_map<const AbstractStage *, Duration> & times)
+: m_valid(false)
+, m_work(Duration::zero())
+, m_criticalPathLength(Duration::zero())
+{
+    analyze(pipeline, times);
+}
+
+PipelineAnalysis::~PipelineAnalysis()
+{
+}
+
+bool PipelineAnalysis::isValid() const
+{
+    return m_valid;
+}
+
+const std::vector<PipelineAnalysis::StageInfo> & PipelineAnalysis::stages() const
+{
+    return m_stages;
+}
+
+PipelineAnalysis::Duration PipelineAnalysis::work() const
+{
+    return m_work;
+}
+
+PipelineAnalysis::Duration PipelineAnalysis::criticalPathLength() const
+{
+    return m_criticalPathLength;
+}
+
+std::vector<const AbstractStage *> PipelineAnalysis::criticalPath() const
+{
+    std::vector<const AbstractStage *> path;
+
+    if (m_stages.empty())
+        return path;
+
+    // Start at the critical stage that finishes last and follow critical predecessors that finish just in time
+    size_t current = m_stages.size();
+
+    for (size_t i = 0; i < m_stages.size(); ++i)
+    {
+        if (m_stages[i].isCritical() && m_stages[i].earliestStart + m_stages[i].time == m_criticalPathLength)
+            current = i;
+    }
+
+    while (current < m_stages.size())
+    {
+        path.push_back(m_stages[current].stage);
+
+        size_t next = m_stages.size();
+
+        for (auto predecessor : m_stages[current].predecessors)
+        {
+            const StageInfo & info = m_stages[predecessor];
+
+            if (info.isCritical() && info.earliestStart + info.time == m_stages[current].earliestStart)
+            {
+                next = predecessor;
+                break;
+            }
+        }
+
+        current = next;
+    }
+
+    std::reverse(path.begin(), path.end());
+
+    return path;
+}
+
+std::vector<const AbstractStage *> PipelineAnalysis::serializingStages() const
+{
+    std::vector<const AbstractStage *> stages;
+
+    for (const StageInfo & info : m_stages)
+    {
+        if (info.serializing)
+            stages.push_back(info.stage);
+    }
+
+    return stages;
+}
+
+double PipelineAnalysis::parallelism() const
+{
+    if (m_criticalPathLength == Duration::zero())
+        return 1.0;
+
+    return static_cast<double>(m_work.count()) / m_criticalPathLength.count();
+}
+
+PipelineAnalysis::Duration PipelineAnalysis::scheduleLength(unsigned int cores) const
+{
+    const size_t numStages = m_stages.size();
+    const size_t numCores = std::max(cores, 1u);
+
+    // Stages with the longest remaining path are scheduled first
+    std::vector<Duration> bottomLevels(numStages, Duration::zero());
+
+    for (size_t i = numStages; i-- > 0;)
+    {
+        Duration remaining = Duration::zero();
+
+        for (auto successor : m_stages[i].successors)
+        {
+            remaining = std::max(remaining, bottomLevels[successor]);
+        }
+
+        bottomLevels[i] = m_stages[i].time + remaining;
+    }
+
+    std::vector<size_t> pendingPredecessors(numStages);
+    std::vector<Duration> readyTimes(numStages, Duration::zero());
+    std::priority_queue<std::pair<Duration::rep, size_t>> ready;
+
+    for (size_t i = 0; i < numStages; ++i)
+    {
+        pendingPredecessors[i] = m_stages[i].predecessors.size();
+
+        if (pendingPredecessors[i] == 0)
+            ready.push(std::make_pair(bottomLevels[i].count(), i));
+    }
+
+    std::vector<Duration> coreTimes(numCores, Duration::zero());
+    Duration length = Duration::zero();
+
+    while (!ready.empty())
+    {
+        const size_t index = ready.top().second;
+        ready.pop();
+
+        const StageInfo & info = m_stages[index];
+
+        // Stages requiring the OpenGL context are processed on the thread owning it
+        size_t core = 0;
+
+        if (!info.stage->requiresContext())
+        {
+            for (size_t i = 1; i < numCores; ++i)
+            {
+                if (std::max(coreTimes[i], readyTimes[index]) < std::max(coreTimes[core], readyTimes[index]))
+                    core = i;
+            }
+        }
+
+        const Duration finish = std::max(coreTimes[core], readyTimes[index]) + info.time;
+        coreTimes[core] = finish;
+        length = std::max(length, finish);
+
+        for (auto successor : info.successors)
+        {
+            readyTimes[successor] = std::max(readyTimes[successor], finish);
+
+            if (--pendingPredecessors[successor] == 0)
+                ready.push(std::make_pair(bottomLevels[successor].count(), successor));
+        }
+    }
+
+    return length;
+}
+
+double PipelineAnalysis::speedup(unsigned int cores) const
+{
+    const Duration length = scheduleLength(cores);
+
+    if (length == Duration::zero())
+        return 1.0;
+
+    return static_cast<double>(m_work.count()) / length.count();
+}
+
+void PipelineAnalysis::writeDot(std::ostream & stream) const
+{
+    const auto flags = stream.flags();
+    const auto precision = stream.precision();
+
+    stream << std::fixed << std::setprecision(3);
+    stream << "digraph pipeline {\n";
+    stream << "    label=\"work " << toMilliseconds(m_work) << " ms, critical path " << toMilliseconds(m_criticalPathLength)
+           << " ms, parallelism " << parallelism() << "\";\n";
+    stream << "    node [shape=box];\n";
+
+    for (size_t i = 0; i < m_stages.size(); ++i)
+    {
+        const StageInfo & info = m_stages[i];
+
+        stream << "    s" << i << " [label=\"" << escapeDot(info.stage->name()) << "\\n" << toMilliseconds(info.time) << " ms";
+
+        if (!info.isCritical())
+            stream << "\\nslack " << toMilliseconds(info.slack()) << " ms";
+
+        stream << "\"";
+
+        if (info.isCritical())
+            stream << ", color=red, penwidth=2";
+
+        if (info.serializing)
+            stream << ", style=filled, fillcolor=lightgray";
+
+        stream << "];\n";
+    }
+
+    for (size_t i = 0; i < m_stages.size(); ++i)
+    {
+        for (auto successor : m_stages[i].successors)
+        {
+            const StageInfo & from = m_stages[i];
+            const StageInfo & to = m_stages[successor];
+
+            stream << "    s" << i << " -> s" << successor;
+
+            if (from.isCritical() && to.isCritical() && from.earliestStart + from.time == to.earliestStart)
+                stream << " [color=red, penwidth=2]";
+
+            stream << ";\n";
+        }
+    }
+
+    stream << "}\n";
+
+    stream.flags(flags);
+    stream.precision(precision);
+}
+
+void PipelineAnalysis::analyze(const AbstractPipeline & pipeline, const std::unordered_map<const AbstractStage *, Duration> & times)
+{
+    const auto & stages = pipeline.stages();
+    const size_t numStages = stages.size();
+
+    std::unordered_map<const AbstractStage *, size_t> indices;
+
+    for (size_t i = 0; i < numStages; ++i)
+    {
+        indices[stages[i]] = i;
+    }
+
+    // Direct requirements, as in AbstractStage::requires(stage, false), restricted to the stages of the pipeline
+    std::vector<std::vector<size_t>> predecessors(numStages);
+
+    auto add = [&indices, &predecessors](size_t index, const AbstractStage * predecessor)
+    {
+        const auto it = indices.find(predecessor);
+
+        if (it == indices.end() || it->second == index)
+            return;
+
+        auto & list = predecessors[index];
+
+        if (std::find(list.begin(), list.end(), it->second) == list.end())
+            list.push_back(it->second);
+    };
+
+    for (size_t i = 0; i < numStages; ++i)
+    {
+        for (auto input : stages[i]->allInputs())
+        {
+            if (!input->isFeedback() && input->connectedData())
+                add(i, input->connectedData()->owner());
+        }
+
+        for (auto dependency : stages[i]->m_dependencies)
+        {
+            add(i, dependency);
+        }
+    }
+
+    // Topological order, keeping the order of the pipeline among independent stages
+    std::vector<std::vector<size_t>> successors(numStages);
+    std::vector<size_t> inDegree(numStages);
+
+    for (size_t i = 0; i < numStages; ++i)
+    {
+        inDegree[i] = predecessors[i].size();
+
+        for (auto predecessor : predecessors[i])
+        {
+            successors[predecessor].push_back(i);
+        }
+    }
+
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> ready;
+
+    for (size_t i = 0; i < numStages; ++i)
+    {
+        if (inDegree[i] == 0)
+            ready.push(i);
+    }
+
+    std::vector<size_t> order;
+    order.reserve(numStages);
+
+    while (!ready.empty())
+    {
+        const size_t index = ready.top();
+        ready.pop();
+
+        order.push_back(index);
+
+        for (auto successor : successors[index])
+        {
+            if (--inDegree[successor] == 0)
+                ready.push(successor);
+        }
+    }
+
+    m_stages.clear();
+
+    if (order.size() != numStages)
+    {
+        m_valid = false;
+        return;
+    }
+
+    std::vector<size_t> positions(numStages);
+
+    for (size_t i = 0; i < numStages; ++i)
+    {
+        positions[order[i]] = i;
+    }
+
+    m_stages.resize(numStages);
+    m_work = Duration::zero();
+
+    for (size_t i = 0; i < numStages; ++i)
+    {
+        const size_t index = order[i];
+        StageInfo & info = m_stages[i];
+
+        const auto it = times.find(stages[index]);
+
+        info.stage = stages[index];
+        info.time = it != times.end() ? it->second : Duration::zero();
+        info.serializing = false;
+
+        for (auto predecessor : predecessors[index])
+        {
+            info.predecessors.push_back(positions[predecessor]);
+        }
+
+        for (auto successor : successors[index])
+        {
+            info.successors.push_back(positions[successor]);
+        }
+
+        m_work += info.time;
+    }
+
+    // Forward pass: earliest starts with unlimited cores
+    m_criticalPathLength = Duration::zero();
+
+    for (StageInfo & info : m_stages)
+    {
+        info.earliestStart = Duration::zero();
+
+        for (auto predecessor : info.predecessors)
+        {
+            info.earliestStart = std::max(info.earliestStart, m_stages[predecessor].earliestStart + m_stages[predecessor].time);
+        }
+
+        m_criticalPathLength = std::max(m_criticalPathLength, info.earliestStart + info.time);
+    }
+
+    // Backward pass: latest starts that keep the critical path length
+    for (size_t i = numStages; i-- > 0;)
+    {
+        StageInfo & info = m_stages[i];
+        Duration latestFinish = m_criticalPathLength;
+
+        for (auto successor : info.successors)
+        {
+            latestFinish = std::min(latestFinish, m_stages[successor].latestStart);
+        }
+
+        info.latestStart = latestFinish - info.time;
+    }
+
+    findSerializingStages();
+
+    m_valid = true;
+}
+
+void PipelineAnalysis::findSerializingStages()
+{
+    const size_t numStages = m_stages.size();
+    const size_t numWords = (numStages + bitsPerWord - 1) / bitsPerWord;
+
+    // Transitive predecessors and successors as bit sets, in topological order
+    std::vector<std::uint64_t> ancestors(numStages * numWords, 0);
+    std::vector<std::uint64_t> descendants(numStages * numWords, 0);
+
+    for (size_t i = 0; i < numStages; ++i)
+    {
+        std::uint64_t * bits = &ancestors[i * numWords];
+
+        for (auto predecessor : m_stages[i].predecessors)
+        {
+            const std::uint64_t * predecessorBits = &ancestors[predecessor * numWords];
+
+            for (size_t word = 0; word < numWords; ++word)
+            {
+                bits[word] |= predecessorBits[word];
+            }
+
+            bits[predecessor / bitsPerWord] |= std::uint64_t(1) << (predecessor % bitsPerWord);
+        }
+    }
+
+    for (size_t i = numStages; i-- > 0;)
+    {
+        std::uint64_t * bits = &descendants[i * numWords];
+
+        for (auto successor : m_stages[i].successors)
+        {
+            const std::uint64_t * successorBits = &descendants[successor * numWords];
+
+            for (size_t word = 0; word < numWords; ++word)
+            {
+                bits[word] |= successorBits[word];
+            }
+
+            bits[successor / bitsPerWord] |= std::uint64_t(1) << (successor % bitsPerWord);
+        }
+    }
+
+    for (size_t i = 0; i < numStages; ++i)
+    {
+        size_t related = 0;
+
+        for (size_t word = 0; word < numWords; ++word)
+        {
+            related += countBits(ancestors[i * numWords + word] | descendants[i * numWords + word]);
+        }
+
+        m_stages[i].serializing = related + 1 == numStages;
+    }
+}
+
+
+} // namespace gloperate
@@ -18,6 +18,11 @@ PipelinePainter::PipelinePainter(
 {
 }
 
+AbstractPipeline & PipelinePainter::pipeline() const
+{
+    return m_pipeline;
+}
+
 void PipelinePainter::onInitialize()
 {
     m_pipeline.initialize();
@@ -0,0 +1,23 @@
+
+#include <gloperate/pipeline/PipelineTransaction.h>
+
+#include <gloperate/pipeline/AbstractPipeline.h>
+
+
+namespace gloperate
+{
+
+
+PipelineTransaction::PipelineTransaction(AbstractPipeline & pipeline)
+: m_pipeline(pipeline)
+{
+    m_pipeline.beginUpdate();
+}
+
+PipelineTransaction::~PipelineTransaction()
+{
+    m_pipeline.endUpdate();
+}
+
+
+} // namespace gloperate
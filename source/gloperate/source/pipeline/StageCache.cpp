@@ -0,0 +1,149 @@
+
+#include <gloperate/pipeline/StageCache.h>
+
+#include <gloperate/pipeline/AbstractData.h>
+
+
+namespace gloperate
+{
+
+
+StageCache::StageCache(size_t capacity)
+:   m_capacity(capacity)
+,   m_hits(0)
+,   m_misses(0)
+{
+}
+
+StageCache::~StageCache()
+{
+}
+
+size_t StageCache::capacity() const
+{
+    return m_capacity;
+}
+
+void StageCache::setCapacity(size_t capacity)
+{
+    m_capacity = capacity;
+
+    while (m_entries.size() > m_capacity)
+    {
+        m_index.erase(combinedHash(m_entries.back().key));
+        m_entries.pop_back();
+    }
+}
+
+size_t StageCache::size() const
+{
+    return m_entries.size();
+}
+
+size_t StageCache::sizeInBytes() const
+{
+    size_t size = 0;
+
+    for (const Entry & entry : m_entries)
+    {
+        for (const auto & snapshot : entry.snapshots)
+        {
+            size += snapshot->sizeInBytes();
+        }
+    }
+
+    return size;
+}
+
+size_t StageCache::hits() const
+{
+    return m_hits;
+}
+
+size_t StageCache::misses() const
+{
+    return m_misses;
+}
+
+bool StageCache::restore(const Key & key, SlotView<AbstractData *> outputs)
+{
+    const auto it = m_index.find(combinedHash(key));
+
+    // Different keys may share a combined hash
+    if (it == m_index.end() || it->second->key != key || it->second->snapshots.size() != outputs.size())
+    {
+        ++m_misses;
+        return false;
+    }
+
+    const Entry & entry = *it->second;
+
+    for (size_t i = 0; i < outputs.size(); ++i)
+    {
+        outputs[i]->restore(*entry.snapshots[i]);
+    }
+
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+    ++m_hits;
+
+    return true;
+}
+
+bool StageCache::store(const Key & key, SlotView<AbstractData *> outputs)
+{
+    if (m_capacity == 0)
+        return false;
+
+    Entry entry;
+    entry.key = key;
+    entry.snapshots.reserve(outputs.size());
+
+    for (AbstractData * output : outputs)
+    {
+        auto snapshot = output->snapshot();
+
+        if (!snapshot)
+            return false;
+
+        entry.snapshots.push_back(snapshot);
+    }
+
+    const size_t hash = combinedHash(key);
+    const auto it = m_index.find(hash);
+
+    if (it != m_index.end())
+    {
+        m_entries.erase(it->second);
+    }
+
+    m_entries.push_front(std::move(entry));
+    m_index[hash] = m_entries.begin();
+
+    setCapacity(m_capacity);
+
+    return true;
+}
+
+void StageCache::clear()
+{
+    m_entries.clear();
+    m_index.clear();
+    m_hits = 0;
+    m_misses = 0;
+}
+
+size_t StageCache::combinedHash(const Key & key)
+{
+    size_t hash = key.size();
+
+    for (size_t value : key)
+    {
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+
+    return hash;
+}
+
+
+} // namespace gloperate
@@ -0,0 +1,331 @@
+
+#include <gloperate/pipeline/StageProfiler.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <ostream>
+
+#include <gloperate/pipeline/AbstractStage.h>
+
+
+namespace
+{
+
+
+double toMicroseconds(gloperate::StageProfiler::Duration duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+double toMilliseconds(gloperate::StageProfiler::Duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+std::string escapeJson(const std::string & str)
+{
+    std::string escaped;
+    escaped.reserve(str.size());
+
+    for (char c : str)
+    {
+        switch (c)
+        {
+        case '"':  escaped += "\\\""; break;
+        case '\\': escaped += "\\\\"; break;
+        case '\n': escaped += "\\n"; break;
+        case '\t': escaped += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) >= 0x20)
+                escaped += c;
+        }
+    }
+
+    return escaped;
+}
+
+
+} // namespace
+
+
+namespace gloperate
+{
+
+
+StageProfiler::StageProfiler(size_t historySize)
+:   m_timer(true, true)
+,   m_historySize(historySize)
+,   m_frameDepth(0)
+,   m_frameCount(0)
+{
+}
+
+StageProfiler::~StageProfiler()
+{
+}
+
+size_t StageProfiler::historySize() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_historySize;
+}
+
+void StageProfiler::setHistorySize(size_t historySize)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_historySize = historySize;
+
+    while (m_frames.size() > m_historySize)
+    {
+        m_frames.pop_front();
+    }
+}
+
+StageProfiler::Duration StageProfiler::timestamp() const
+{
+    // The timer updates its cached state on each query
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_timer.elapsed();
+}
+
+void StageProfiler::beginFrame()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_frameDepth++ > 0)
+        return;
+
+    ++m_frameCount;
+
+    if (m_historySize == 0)
+        return;
+
+    Frame frame;
+    frame.start = m_timer.elapsed();
+    frame.duration = Duration::zero();
+    frame.thread = std::this_thread::get_id();
+
+    if (m_frames.size() == m_historySize)
+    {
+        // Reuse the storage of the oldest frame
+        frame.events = std::move(m_frames.front().events);
+        frame.events.clear();
+        m_frames.pop_front();
+    }
+
+    m_frames.push_back(std::move(frame));
+}
+
+void StageProfiler::endFrame(const std::vector<AbstractStage *> & stages)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_frameDepth == 0 || --m_frameDepth > 0)
+        return;
+
+    if (!m_frames.empty())
+        m_frames.back().duration = m_timer.elapsed() - m_frames.back().start;
+
+    // Clean stages are not visited by the pipeline, so skips are counted here
+    for (const AbstractStage * stage : stages)
+    {
+        Statistics & statistics = stageStatistics(stage);
+
+        if (m_lastFrames[m_stageIndices[stage]] != m_frameCount)
+            ++statistics.skips;
+    }
+}
+
+void StageProfiler::recordExecution(const AbstractStage * stage, Duration start, Duration duration)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Statistics & statistics = stageStatistics(stage);
+
+    statistics.minTime = statistics.invocations == 0 ? duration : std::min(statistics.minTime, duration);
+    statistics.maxTime = std::max(statistics.maxTime, duration);
+    statistics.totalTime += duration;
+    ++statistics.invocations;
+
+    const size_t stageIndex = m_stageIndices[stage];
+
+    // Executions outside of a frame only contribute to the statistics
+    if (m_frameDepth == 0)
+        return;
+
+    m_lastFrames[stageIndex] = m_frameCount;
+
+    if (m_frames.empty())
+        return;
+
+    Event event;
+    event.stageIndex = stageIndex;
+    event.start = start;
+    event.duration = duration;
+    event.thread = std::this_thread::get_id();
+
+    m_frames.back().events.push_back(event);
+}
+
+std::vector<StageProfiler::Statistics> StageProfiler::statistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_statistics;
+}
+
+StageProfiler::Duration StageProfiler::meanTime(const AbstractStage * stage) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto it = m_stageIndices.find(stage);
+
+    if (it == m_stageIndices.end() || m_statistics[it->second].invocations == 0)
+        return Duration::zero();
+
+    const Statistics & statistics = m_statistics[it->second];
+
+    return statistics.totalTime / statistics.invocations;
+}
+
+std::deque<StageProfiler::Frame> StageProfiler::frames() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_frames;
+}
+
+void StageProfiler::reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stageIndices.clear();
+    m_statistics.clear();
+    m_lastFrames.clear();
+    m_frames.clear();
+    m_frameDepth = 0;
+}
+
+void StageProfiler::writeTrace(std::ostream & stream) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // The trace format expects numeric thread ids, number them in order of appearance
+    std::map<std::thread::id, size_t> threadIds;
+    auto threadId = [&threadIds](std::thread::id id)
+    {
+        return threadIds.insert(std::make_pair(id, threadIds.size())).first->second;
+    };
+
+    auto writeEvent = [&stream, &threadId](const std::string & name, const char * category, Duration start, Duration duration, std::thread::id thread)
+    {
+        stream << "{\"name\":\"" << escapeJson(name) << "\",\"cat\":\"" << category << "\",\"ph\":\"X\""
+               << ",\"ts\":" << toMicroseconds(start) << ",\"dur\":" << toMicroseconds(duration)
+               << ",\"pid\":0,\"tid\":" << threadId(thread) << "}";
+    };
+
+    const auto flags = stream.flags();
+    const auto precision = stream.precision();
+
+    stream << std::fixed << std::setprecision(3);
+    stream << "{\"traceEvents\":[";
+
+    bool first = true;
+
+    for (size_t i = 0; i < m_frames.size(); ++i)
+    {
+        const Frame & frame = m_frames[i];
+
+        stream << (first ? "\n" : ",\n");
+        first = false;
+
+        writeEvent("Frame", "frame", frame.start, frame.duration, frame.thread);
+
+        for (const Event & event : frame.events)
+        {
+            stream << ",\n";
+            writeEvent(m_statistics[event.stageIndex].stageName, "stage", event.start, event.duration, event.thread);
+        }
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+
+    stream.flags(flags);
+    stream.precision(precision);
+}
+
+void StageProfiler::writeSummary(std::ostream & stream) const
+{
+    std::vector<Statistics> statistics = this->statistics();
+
+    std::stable_sort(statistics.begin(), statistics.end(), [](const Statistics & lhs, const Statistics & rhs)
+    {
+        return lhs.totalTime > rhs.totalTime;
+    });
+
+    size_t nameWidth = 5;
+
+    for (const Statistics & stats : statistics)
+    {
+        nameWidth = std::max(nameWidth, stats.stageName.size());
+    }
+
+    const auto flags = stream.flags();
+    const auto precision = stream.precision();
+
+    stream << std::left << std::setw(nameWidth) << "Stage" << std::right
+           << std::setw(10) << "Calls"
+           << std::setw(10) << "Skips"
+           << std::setw(12) << "Total [ms]"
+           << std::setw(12) << "Mean [ms]"
+           << std::setw(12) << "Min [ms]"
+           << std::setw(12) << "Max [ms]" << std::endl;
+
+    stream << std::fixed << std::setprecision(3);
+
+    for (const Statistics & stats : statistics)
+    {
+        const auto mean = stats.invocations > 0 ? toMilliseconds(stats.totalTime) / stats.invocations : 0.0;
+
+        stream << std::left << std::setw(nameWidth) << stats.stageName << std::right
+               << std::setw(10) << stats.invocations
+               << std::setw(10) << stats.skips
+               << std::setw(12) << toMilliseconds(stats.totalTime)
+               << std::setw(12) << mean
+               << std::setw(12) << toMilliseconds(stats.minTime)
+               << std::setw(12) << toMilliseconds(stats.maxTime) << std::endl;
+    }
+
+    stream.flags(flags);
+    stream.precision(precision);
+}
+
+StageProfiler::Statistics & StageProfiler::stageStatistics(const AbstractStage * stage)
+{
+    auto it = m_stageIndices.find(stage);
+
+    if (it != m_stageIndices.end())
+        return m_statistics[it->second];
+
+    m_stageIndices[stage] = m_statistics.size();
+
+    Statistics statistics;
+    statistics.stageName = stage->asPrintable();
+    statistics.invocations = 0;
+    statistics.skips = 0;
+    statistics.totalTime = Duration::zero();
+    statistics.minTime = Duration::zero();
+    statistics.maxTime = Duration::zero();
+
+    m_statistics.push_back(statistics);
+    m_lastFrames.push_back(0);
+
+    return m_statistics.back();
+}
+
+
+} // namespace gloperate
@@ -0,0 +1,96 @@
+
+#include <gloperate/pipeline/TypeToken.h>
+
+#include <cstdint>
+#include <cstring>
+
+
+namespace
+{
+
+
+// Locates the type argument in the signature of TypeToken<T>::signature()
+void findTypeName(const char * signature, const char * & begin, const char * & end)
+{
+    begin = signature;
+    end = signature + std::strlen(signature);
+
+    // GCC: "... TypeToken<T>::signature() [with T = int]", Clang: "... [T = int]"
+    const char * argument = std::strstr(signature, "T = ");
+
+    if (argument && end > argument && *(end - 1) == ']')
+    {
+        begin = argument + 4;
+        --end;
+        return;
+    }
+
+    // MSVC: "... TypeToken<int>::signature(void)"
+    const char * prefix = std::strstr(signature, "TypeToken<");
+
+    if (!prefix)
+        return;
+
+    const char * suffix = nullptr;
+
+    for (const char * position = std::strstr(prefix, ">::signature"); position; position = std::strstr(position + 1, ">::signature"))
+    {
+        suffix = position;
+    }
+
+    if (suffix)
+    {
+        begin = prefix + 10;
+        end = suffix;
+    }
+}
+
+size_t hashTypeName(const char * begin, const char * end)
+{
+    // FNV-1a
+    std::uint64_t hash = 14695981039346656037ull;
+
+    for (const char * character = begin; character != end; ++character)
+    {
+        hash ^= static_cast<unsigned char>(*character);
+        hash *= 1099511628211ull;
+    }
+
+    return static_cast<size_t>(hash);
+}
+
+
+} // namespace
+
+
+namespace gloperate
+{
+
+
+size_t typeIdFromName(const std::string & typeName)
+{
+    return hashTypeName(typeName.data(), typeName.data() + typeName.size());
+}
+
+size_t typeIdFromSignature(const char * signature)
+{
+    const char * begin = nullptr;
+    const char * end = nullptr;
+
+    findTypeName(signature, begin, end);
+
+    return hashTypeName(begin, end);
+}
+
+std::string typeNameFromSignature(const char * signature)
+{
+    const char * begin = nullptr;
+    const char * end = nullptr;
+
+    findTypeName(signature, begin, end);
+
+    return std::string(begin, end);
+}
+
+
+} // namespace gloperate
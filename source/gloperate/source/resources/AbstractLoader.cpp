@@ -6,6 +6,11 @@ namespace gloperate
 {
 
 
+AbstractLoader::Prepared::~Prepared()
+{
+}
+
+
 AbstractLoader::AbstractLoader()
 {
 }
@@ -14,5 +19,15 @@ AbstractLoader::~AbstractLoader()
 {
 }
 
+bool AbstractLoader::requiresContext() const
+{
+    return true;
+}
+
+bool AbstractLoader::canLoadContent(const char * /*header*/, size_t /*size*/) const
+{
+    return false;
+}
+
 
 } // namespace gloperate
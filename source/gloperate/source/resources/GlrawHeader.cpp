@@ -0,0 +1,320 @@
+
+#include <gloperate/resources/GlrawHeader.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include <glbinding/gl/gl.h>
+
+#include <gloperate/resources/RawFile.h>
+
+
+namespace
+{
+
+
+const std::uint16_t s_magicNumber = 0xC4F3;
+
+enum PropertyType : std::uint8_t
+{
+    IntegerType = 1,
+    DoubleType = 2,
+    StringType = 3
+};
+
+
+template <typename T>
+bool readValue(const std::vector<char> & header, size_t & pos, T & value)
+{
+    if (pos + sizeof(T) > header.size())
+        return false;
+
+    // glraw writes little-endian values
+    std::memcpy(&value, header.data() + pos, sizeof(T));
+    pos += sizeof(T);
+
+    return true;
+}
+
+bool readString(const std::vector<char> & header, size_t & pos, std::string & value)
+{
+    const auto end = std::find(header.begin() + pos, header.end(), '\0');
+
+    if (end == header.end())
+        return false;
+
+    value.assign(header.begin() + pos, end);
+    pos = static_cast<size_t>(end - header.begin()) + 1;
+
+    return true;
+}
+
+size_t componentCount(gl::GLenum format)
+{
+    switch (format)
+    {
+    case gl::GL_RED:
+    case gl::GL_GREEN:
+    case gl::GL_BLUE:
+    case gl::GL_ALPHA:
+    case gl::GL_LUMINANCE:
+    case gl::GL_DEPTH_COMPONENT:
+        return 1;
+
+    case gl::GL_RG:
+    case gl::GL_LUMINANCE_ALPHA:
+        return 2;
+
+    case gl::GL_RGB:
+    case gl::GL_BGR:
+        return 3;
+
+    case gl::GL_RGBA:
+    case gl::GL_BGRA:
+        return 4;
+
+    default:
+        return 0;
+    }
+}
+
+size_t pixelSize(gl::GLenum format, gl::GLenum type)
+{
+    switch (type)
+    {
+    case gl::GL_UNSIGNED_BYTE:
+    case gl::GL_BYTE:
+        return componentCount(format);
+
+    case gl::GL_UNSIGNED_SHORT:
+    case gl::GL_SHORT:
+    case gl::GL_HALF_FLOAT:
+        return componentCount(format) * 2;
+
+    case gl::GL_UNSIGNED_INT:
+    case gl::GL_INT:
+    case gl::GL_FLOAT:
+        return componentCount(format) * 4;
+
+    // Packed types store all components of a pixel in one value
+    case gl::GL_UNSIGNED_BYTE_3_3_2:
+    case gl::GL_UNSIGNED_BYTE_2_3_3_REV:
+        return 1;
+
+    case gl::GL_UNSIGNED_SHORT_5_6_5:
+    case gl::GL_UNSIGNED_SHORT_5_6_5_REV:
+    case gl::GL_UNSIGNED_SHORT_4_4_4_4:
+    case gl::GL_UNSIGNED_SHORT_4_4_4_4_REV:
+    case gl::GL_UNSIGNED_SHORT_5_5_5_1:
+    case gl::GL_UNSIGNED_SHORT_1_5_5_5_REV:
+        return 2;
+
+    case gl::GL_UNSIGNED_INT_8_8_8_8:
+    case gl::GL_UNSIGNED_INT_8_8_8_8_REV:
+    case gl::GL_UNSIGNED_INT_10_10_10_2:
+    case gl::GL_UNSIGNED_INT_2_10_10_10_REV:
+        return 4;
+
+    default:
+        return 0;
+    }
+}
+
+
+} // namespace
+
+
+namespace gloperate
+{
+
+
+bool GlrawHeader::hasMagicNumber(const char * data, size_t size)
+{
+    std::uint16_t magicNumber = 0;
+
+    if (size < sizeof(magicNumber))
+        return false;
+
+    std::memcpy(&magicNumber, data, sizeof(magicNumber));
+
+    return magicNumber == s_magicNumber;
+}
+
+GlrawHeader::GlrawHeader()
+: m_dataOffset(0)
+, m_dataSize(0)
+{
+}
+
+bool GlrawHeader::read(const RawFile & file)
+{
+    m_properties.clear();
+    m_dataOffset = 0;
+    m_levels.clear();
+    m_dataSize = 0;
+
+    std::uint16_t magicNumber = 0;
+    std::uint64_t offset = 0;
+
+    const size_t prefixSize = sizeof(magicNumber) + sizeof(offset);
+    std::vector<char> header(prefixSize);
+
+    if (file.read(0, prefixSize, header.data()) != prefixSize)
+        return false;
+
+    size_t pos = 0;
+    readValue(header, pos, magicNumber);
+    readValue(header, pos, offset);
+
+    if (magicNumber != s_magicNumber || offset < prefixSize || offset > file.size())
+        return false;
+
+    header.resize(static_cast<size_t>(offset));
+
+    if (file.read(prefixSize, header.size() - prefixSize, header.data() + prefixSize) != header.size() - prefixSize)
+        return false;
+
+    std::map<std::string, int> properties;
+
+    while (pos < header.size())
+    {
+        std::uint8_t type = 0;
+        std::string key;
+
+        if (!readValue(header, pos, type) || !readString(header, pos, key))
+            return false;
+
+        // Only integer properties describe the texture
+        switch (type)
+        {
+        case IntegerType:
+            {
+                std::int32_t value = 0;
+                if (!readValue(header, pos, value))
+                    return false;
+
+                properties[key] = value;
+            }
+            break;
+
+        case DoubleType:
+            {
+                double value = 0.0;
+                if (!readValue(header, pos, value))
+                    return false;
+            }
+            break;
+
+        case StringType:
+            {
+                std::string value;
+                if (!readString(header, pos, value))
+                    return false;
+            }
+            break;
+
+        default:
+            return false;
+        }
+    }
+
+    m_properties = std::move(properties);
+    m_dataOffset = static_cast<size_t>(offset);
+
+    computeLevels();
+
+    return true;
+}
+
+int GlrawHeader::property(const std::string & key, int defaultValue) const
+{
+    const auto it = m_properties.find(key);
+
+    return it != m_properties.end() ? it->second : defaultValue;
+}
+
+const std::map<std::string, int> & GlrawHeader::properties() const
+{
+    return m_properties;
+}
+
+bool GlrawHeader::isCompressed() const
+{
+    return m_properties.count("compressedFormat") > 0;
+}
+
+size_t GlrawHeader::dataOffset() const
+{
+    return m_dataOffset;
+}
+
+const std::vector<GlrawHeader::Level> & GlrawHeader::levels() const
+{
+    return m_levels;
+}
+
+size_t GlrawHeader::dataSize() const
+{
+    return m_dataSize;
+}
+
+bool GlrawHeader::isComplete(size_t fileSize) const
+{
+    return !m_levels.empty() && fileSize >= m_dataOffset && fileSize - m_dataOffset >= m_dataSize;
+}
+
+void GlrawHeader::computeLevels()
+{
+    const int width = property("width");
+    const int height = property("height");
+    const int levelCount = property("levels", 1);
+
+    // The smallest level is 1x1
+    int maxLevelCount = 1;
+    while ((std::max(width, height) >> maxLevelCount) > 0)
+        ++maxLevelCount;
+
+    if (width <= 0 || height <= 0 || levelCount <= 0 || levelCount > maxLevelCount)
+        return;
+
+    const bool compressed = isCompressed();
+
+    size_t unitSize = 0;
+
+    if (compressed)
+    {
+        // Compressed formats use 4x4 blocks, the size of one is derived from the first level
+        const size_t blocks = static_cast<size_t>((width + 3) / 4) * static_cast<size_t>((height + 3) / 4);
+        const size_t size = static_cast<size_t>(std::max(property("size"), 0));
+
+        if (size % blocks == 0)
+            unitSize = size / blocks;
+    }
+    else
+    {
+        unitSize = pixelSize(
+            static_cast<gl::GLenum>(property("format")),
+            static_cast<gl::GLenum>(property("type"))
+        );
+    }
+
+    if (unitSize == 0)
+        return;
+
+    for (int i = 0; i < levelCount; ++i)
+    {
+        Level level;
+        level.width = std::max(width >> i, 1);
+        level.height = std::max(height >> i, 1);
+        level.rowHeight = compressed ? 4 : 1;
+        level.rows = static_cast<size_t>((level.height + level.rowHeight - 1) / level.rowHeight);
+        level.rowSize = static_cast<size_t>((level.width + level.rowHeight - 1) / level.rowHeight) * unitSize;
+
+        m_levels.push_back(level);
+        m_dataSize += level.rows * level.rowSize;
+    }
+}
+
+
+} // namespace gloperate
@@ -1,8 +1,42 @@
 
 #include <gloperate/resources/GlrawTextureLoader.h>
 
+#include <algorithm>
+#include <iostream>
+
 #include <reflectionzeug/variant/Variant.h>
- 
+
+#include <glbinding/gl/gl.h>
+
+#include <globjects/base/ref_ptr.h>
+#include <globjects/Buffer.h>
+
+#include <gloperate/base/make_unique.hpp>
+#include <gloperate/resources/GlrawHeader.h>
+#include <gloperate/resources/RawFile.h>
+
+
+namespace
+{
+
+
+// Upload granularity, large enough to keep the driver busy and small enough not to stall it
+const size_t s_chunkSize = 4 * 1024 * 1024;
+
+// Stride for touching mapped pages, the smallest common page size
+const size_t s_pageSize = 4096;
+
+
+class PreparedGlraw : public gloperate::AbstractLoader::Prepared
+{
+public:
+    std::unique_ptr<gloperate::RawFile> file;
+    gloperate::GlrawHeader header;
+};
+
+
+} // namespace
+
 
 namespace gloperate
 {
@@ -19,7 +53,7 @@ GlrawTextureLoader::~GlrawTextureLoader()
 
 bool GlrawTextureLoader::canLoad(const std::string & ext) const
 {
-    return (ext == ".glraw");
+    return (ext == "glraw");
 }
 
 std::vector<std::string> GlrawTextureLoader::loadingTypes() const
@@ -36,10 +70,157 @@ std::string GlrawTextureLoader::allLoadingTypes() const
     return "*.glraw";
 }
 
-globjects::Texture * GlrawTextureLoader::load(const std::string & /*filename*/, const reflectionzeug::Variant & /*options*/, std::function<void(int, int)> /*progress*/) const
+bool GlrawTextureLoader::canLoadContent(const char * header, size_t size) const
+{
+    return GlrawHeader::hasMagicNumber(header, size);
+}
+
+globjects::Texture * GlrawTextureLoader::load(const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> progress) const
+{
+    return finish(filename, options, prepare(filename, options, progress), progress);
+}
+
+std::unique_ptr<AbstractLoader::Prepared> GlrawTextureLoader::prepare(const std::string & filename, const reflectionzeug::Variant & /*options*/, std::function<void(int, int)> /*progress*/) const
+{
+    // Map file
+    auto preparedGlraw = new PreparedGlraw;
+    std::unique_ptr<Prepared> prepared(preparedGlraw);
+    preparedGlraw->file = make_unique<RawFile>(filename);
+
+    if (!preparedGlraw->file->isValid())
+    {
+        return nullptr;
+    }
+
+    const RawFile & file = *preparedGlraw->file;
+    const GlrawHeader & header = preparedGlraw->header;
+
+    if (!preparedGlraw->header.read(file))
+    {
+        std::cerr << "Reading glraw header of \"" << filename << "\" failed." << std::endl;
+        return nullptr;
+    }
+
+    // Check that the file contains all levels
+    if (!header.isComplete(file.size()))
+    {
+        std::cerr << "Glraw file \"" << filename << "\" is invalid or incomplete." << std::endl;
+        return nullptr;
+    }
+
+    // Read the mapped pages on this thread, so that the upload does not wait for the disk.
+    // The pages can still be dropped under memory pressure and are then read again by the upload.
+    const char * data = file.data();
+    volatile char sink = 0;
+
+    for (size_t offset = header.dataOffset(); offset < header.dataOffset() + header.dataSize(); offset += s_pageSize)
+    {
+        sink ^= data[offset];
+    }
+
+    return prepared;
+}
+
+globjects::Texture * GlrawTextureLoader::finish(const std::string & /*filename*/, const reflectionzeug::Variant & /*options*/, std::unique_ptr<Prepared> prepared, std::function<void(int, int)> progress) const
 {
-    // [TODO] Implement!
-    return nullptr;
+    const PreparedGlraw * preparedGlraw = static_cast<const PreparedGlraw *>(prepared.get());
+    if (!preparedGlraw)
+    {
+        return nullptr;
+    }
+
+    const RawFile & file = *preparedGlraw->file;
+    const GlrawHeader & header = preparedGlraw->header;
+    const std::vector<GlrawHeader::Level> & levels = header.levels();
+
+    size_t chunkCount = 0;
+
+    for (const GlrawHeader::Level & level : levels)
+    {
+        const size_t rowsPerChunk = std::max(s_chunkSize / level.rowSize, size_t(1));
+
+        chunkCount += (level.rows + rowsPerChunk - 1) / rowsPerChunk;
+    }
+
+    const bool compressed = header.isCompressed();
+    const auto compressedFormat = static_cast<gl::GLenum>(header.property("compressedFormat"));
+    const auto format = static_cast<gl::GLenum>(header.property("format"));
+    const auto type = static_cast<gl::GLenum>(header.property("type"));
+
+    // Allocate all levels before a pixel unpack buffer is bound
+    globjects::Texture * texture = globjects::Texture::createDefault(gl::GL_TEXTURE_2D);
+
+    if (levels.size() > 1)
+    {
+        texture->setParameter(gl::GL_TEXTURE_MIN_FILTER, gl::GL_LINEAR_MIPMAP_LINEAR);
+        texture->setParameter(gl::GL_TEXTURE_MAX_LEVEL, static_cast<gl::GLint>(levels.size() - 1));
+    }
+
+    for (size_t i = 0; i < levels.size(); ++i)
+    {
+        const GlrawHeader::Level & level = levels[i];
+
+        if (compressed)
+        {
+            texture->compressedImage2D(static_cast<gl::GLint>(i), compressedFormat, level.width, level.height, 0,
+                static_cast<gl::GLsizei>(level.rows * level.rowSize), nullptr);
+        }
+        else
+        {
+            texture->image2D(static_cast<gl::GLint>(i), format, level.width, level.height, 0, format, type, nullptr);
+        }
+    }
+
+    // Upload chunks of rows, each one is read from the mapped file straight into the buffer
+    globjects::ref_ptr<globjects::Buffer> buffer = new globjects::Buffer;
+
+    texture->bind();
+    buffer->bind(gl::GL_PIXEL_UNPACK_BUFFER);
+
+    gl::GLint alignment = 4;
+    gl::glGetIntegerv(gl::GL_UNPACK_ALIGNMENT, &alignment);
+    gl::glPixelStorei(gl::GL_UNPACK_ALIGNMENT, 1);
+
+    const char * data = file.data() + header.dataOffset();
+    size_t chunk = 0;
+
+    for (size_t i = 0; i < levels.size(); ++i)
+    {
+        const GlrawHeader::Level & level = levels[i];
+        const size_t rowsPerChunk = std::max(s_chunkSize / level.rowSize, size_t(1));
+
+        for (size_t row = 0; row < level.rows; row += rowsPerChunk)
+        {
+            const size_t rows = std::min(rowsPerChunk, level.rows - row);
+            const size_t size = rows * level.rowSize;
+
+            const int y = static_cast<int>(row) * level.rowHeight;
+            const int height = std::min(static_cast<int>(rows) * level.rowHeight, level.height - y);
+
+            // Respecifying the store orphans the previous chunk, so this does not wait for its upload
+            buffer->setData(static_cast<gl::GLsizeiptr>(size), data, gl::GL_STREAM_DRAW);
+
+            if (compressed)
+            {
+                gl::glCompressedTexSubImage2D(gl::GL_TEXTURE_2D, static_cast<gl::GLint>(i), 0, y, level.width, height,
+                    compressedFormat, static_cast<gl::GLsizei>(size), nullptr);
+            }
+            else
+            {
+                texture->subImage2D(static_cast<gl::GLint>(i), 0, y, level.width, height, format, type, nullptr);
+            }
+
+            data += size;
+
+            if (progress) progress(static_cast<int>(++chunk), static_cast<int>(chunkCount));
+        }
+    }
+
+    gl::glPixelStorei(gl::GL_UNPACK_ALIGNMENT, alignment);
+    globjects::Buffer::unbind(gl::GL_PIXEL_UNPACK_BUFFER);
+    texture->unbind();
+
+    return texture;
 }
 
 
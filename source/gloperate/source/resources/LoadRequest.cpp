@@ -0,0 +1,212 @@
+
+#include <gloperate/resources/LoadRequest.h>
+
+#include <algorithm>
+
+
+namespace gloperate
+{
+
+
+AbstractLoadRequest::AbstractLoadRequest(const std::string & filename, std::function<void(int, int)> progress)
+: m_filename(filename)
+, m_progressCallback(progress)
+, m_status(Status::Queued)
+, m_cancelRequested(false)
+, m_uploadStarted(false)
+, m_progressCurrent(0)
+, m_progressTotal(0)
+{
+}
+
+AbstractLoadRequest::~AbstractLoadRequest()
+{
+}
+
+const std::string & AbstractLoadRequest::filename() const
+{
+    return m_filename;
+}
+
+AbstractLoadRequest::Status AbstractLoadRequest::status() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_status;
+}
+
+bool AbstractLoadRequest::isDone() const
+{
+    const Status current = status();
+
+    return current == Status::Finished || current == Status::Canceled;
+}
+
+float AbstractLoadRequest::progress() const
+{
+    if (status() == Status::Finished)
+        return 1.0f;
+
+    const int total = m_progressTotal;
+
+    if (total <= 0)
+        return 0.0f;
+
+    return std::min(std::max(static_cast<float>(m_progressCurrent) / total, 0.0f), 1.0f);
+}
+
+bool AbstractLoadRequest::cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        switch (m_status)
+        {
+        case Status::Queued:
+            break;
+
+        case Status::Loading:
+            // The prepared data is discarded once the loading thread is done
+            m_cancelRequested = true;
+            return requiresContext();
+
+        case Status::Uploading:
+            if (m_uploadStarted)
+                return false;
+            break;
+
+        case Status::Finished:
+            return false;
+
+        case Status::Canceled:
+            return true;
+        }
+
+        m_status = Status::Canceled;
+    }
+
+    discardResource();
+    publishResource();
+
+    return true;
+}
+
+bool AbstractLoadRequest::load()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_status != Status::Queued)
+            return false;
+
+        m_status = Status::Loading;
+    }
+
+    if (!requiresContext())
+    {
+        try
+        {
+            loadResource();
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_status = Status::Finished;
+        }
+
+        publishResource();
+
+        return false;
+    }
+
+    try
+    {
+        prepareResource();
+    }
+    catch (...)
+    {
+        fail(std::current_exception());
+        return false;
+    }
+
+    return true;
+}
+
+bool AbstractLoadRequest::markUploading()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_cancelRequested)
+        {
+            m_status = Status::Uploading;
+            return true;
+        }
+
+        m_status = Status::Canceled;
+    }
+
+    discardResource();
+    publishResource();
+
+    return false;
+}
+
+void AbstractLoadRequest::upload()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_status != Status::Uploading)
+            return;
+
+        m_uploadStarted = true;
+    }
+
+    try
+    {
+        finishResource();
+    }
+    catch (...)
+    {
+        fail(std::current_exception());
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_status = Status::Finished;
+    }
+
+    publishResource();
+}
+
+void AbstractLoadRequest::fail(std::exception_ptr exception)
+{
+    discardResource();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_exception = exception;
+        m_status = Status::Finished;
+    }
+
+    publishResource();
+}
+
+void AbstractLoadRequest::reportProgress(int current, int total)
+{
+    m_progressCurrent = current;
+    m_progressTotal = total;
+
+    if (m_progressCallback)
+        m_progressCallback(current, total);
+}
+
+
+} // namespace gloperate
@@ -1,23 +1,79 @@
 
 #include <gloperate/resources/RawFile.h>
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 
 namespace gloperate
 {
 
 
-RawFile::RawFile(const std::string & filePath)
+RawFile::RawFile(const std::string & filePath, Mode mode)
 : m_filePath(filePath)
+, m_mode(mode)
 , m_valid(false)
+, m_mappedData(nullptr)
+, m_size(0)
+, m_fileHandle(nullptr)
+{
+    switch (m_mode)
+    {
+    case Mode::Map:
+        m_valid = mapFile();
+
+        if (!m_valid)
+        {
+            m_mode = Mode::Read;
+            m_valid = readFile();
+        }
+        break;
+
+    case Mode::Read:
+        m_valid = readFile();
+        break;
+
+    case Mode::Stream:
+        m_valid = queryFileSize();
+        break;
+    }
+}
+
+RawFile::RawFile(RawFile && other)
+: m_filePath(other.m_filePath)
+, m_mode(other.m_mode)
+, m_data(std::move(other.m_data))
+, m_valid(other.m_valid)
+, m_mappedData(other.m_mappedData)
+, m_size(other.m_size)
+, m_fileHandle(other.m_fileHandle)
 {
-    m_valid = readFile();
+    other.m_valid = false;
+    other.m_mappedData = nullptr;
+    other.m_size = 0;
+    other.m_fileHandle = nullptr;
 }
 
 RawFile::~RawFile()
 {
+    unmapFile();
 }
 
 bool RawFile::isValid() const
@@ -32,12 +88,41 @@ const std::string & RawFile::filePath() const
 
 const char * RawFile::data() const
 {
-    return m_data.data();
+    if (m_mappedData)
+        return m_mappedData;
+
+    return m_mode == Mode::Read ? m_data.data() : nullptr;
 }
 
 size_t RawFile::size() const
 {
-    return m_data.size();
+    return m_size;
+}
+
+RawFile::Mode RawFile::mode() const
+{
+    return m_mode;
+}
+
+size_t RawFile::read(std::uint64_t offset, size_t size, char * destination) const
+{
+    if (!m_valid || offset >= m_size)
+        return 0;
+
+    const size_t available = std::min(size, static_cast<size_t>(m_size - offset));
+
+    if (m_mode != Mode::Stream)
+    {
+        std::memcpy(destination, data() + offset, available);
+        return available;
+    }
+
+    // Each call uses its own stream, so ranges can be read concurrently
+    std::ifstream ifs(m_filePath, std::ios::in | std::ios::binary);
+    ifs.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+    ifs.read(destination, static_cast<std::streamsize>(available));
+
+    return static_cast<size_t>(ifs.gcount());
 }
 
 bool RawFile::readFile()
@@ -49,7 +134,7 @@ bool RawFile::readFile()
         std::cerr << "Reading from file \"" << m_filePath << "\" failed." << std::endl;
         return false;
     }
-    
+
     readRawData(ifs);
 
     ifs.close();
@@ -63,10 +148,115 @@ void RawFile::readRawData(std::ifstream & ifs)
 
     const size_t size = ifs.tellg();
     m_data.resize(size);
+    m_size = size;
 
     ifs.seekg(0, std::ios::beg);
     ifs.read(m_data.data(), size);
 }
 
+bool RawFile::mapFile()
+{
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(m_filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+
+    // Empty files cannot be mapped
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0 || static_cast<unsigned long long>(fileSize.QuadPart) > static_cast<size_t>(-1))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    // The mapping object keeps the file open
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+
+    if (!mapping)
+        return false;
+
+    const void * view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (!view)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    m_mappedData = static_cast<const char *>(view);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    m_fileHandle = mapping;
+
+    return true;
+#else
+    const int file = open(m_filePath.c_str(), O_RDONLY);
+
+    if (file < 0)
+        return false;
+
+    struct stat status;
+
+    // Empty files cannot be mapped
+    if (fstat(file, &status) != 0 || status.st_size <= 0 || static_cast<unsigned long long>(status.st_size) > static_cast<size_t>(-1))
+    {
+        close(file);
+        return false;
+    }
+
+    const size_t size = static_cast<size_t>(status.st_size);
+
+    // The mapping keeps the file open
+    void * mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+
+    if (mapping == MAP_FAILED)
+        return false;
+
+    // Raw data is usually consumed front to back right away, e.g., by a texture upload
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    madvise(mapping, size, MADV_WILLNEED);
+
+    m_mappedData = static_cast<const char *>(mapping);
+    m_size = size;
+
+    return true;
+#endif
+}
+
+bool RawFile::queryFileSize()
+{
+    std::ifstream ifs(m_filePath, std::ios::in | std::ios::binary);
+
+    if (!ifs)
+    {
+        std::cerr << "Reading from file \"" << m_filePath << "\" failed." << std::endl;
+        return false;
+    }
+
+    ifs.seekg(0, std::ios::end);
+    m_size = static_cast<size_t>(ifs.tellg());
+
+    return true;
+}
+
+void RawFile::unmapFile()
+{
+    if (!m_mappedData)
+        return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(m_mappedData);
+    CloseHandle(m_fileHandle);
+#else
+    munmap(const_cast<char *>(m_mappedData), m_size);
+#endif
+
+    m_mappedData = nullptr;
+    m_fileHandle = nullptr;
+}
+
 
 } // namespace gloperate
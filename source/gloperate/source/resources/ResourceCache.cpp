@@ -0,0 +1,230 @@
+
+#include <gloperate/resources/ResourceCache.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+
+
+namespace
+{
+
+
+double toKibibytes(size_t bytes)
+{
+    return static_cast<double>(bytes) / 1024.0;
+}
+
+
+} // namespace
+
+
+namespace gloperate
+{
+
+
+ResourceCache::ResourceCache(size_t budget)
+: m_budget(budget)
+, m_bytes(0)
+, m_peakBytes(0)
+, m_hits(0)
+, m_misses(0)
+, m_evictions(0)
+{
+}
+
+ResourceCache::~ResourceCache()
+{
+}
+
+size_t ResourceCache::budget() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_budget;
+}
+
+void ResourceCache::setBudget(size_t budget)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_budget = budget;
+
+    evict();
+}
+
+ResourceCache::Statistics ResourceCache::statistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Statistics statistics;
+    statistics.hits = m_hits;
+    statistics.misses = m_misses;
+    statistics.evictions = m_evictions;
+    statistics.entries = m_entries.size();
+    statistics.bytes = m_bytes;
+    statistics.peakBytes = m_peakBytes;
+
+    return statistics;
+}
+
+ResourceCache::Resource ResourceCache::get(const std::string & key, const LoadFunction & load)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    auto it = m_index.find(key);
+
+    // Wait for concurrent loads of the same resource
+    while (it != m_index.end() && it->second->loading)
+    {
+        m_loaded.wait(lock);
+        it = m_index.find(key);
+    }
+
+    if (it != m_index.end())
+    {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        ++m_hits;
+
+        return it->second->resource;
+    }
+
+    ++m_misses;
+
+    Entry placeholder;
+    placeholder.key = key;
+    placeholder.bytes = 0;
+    placeholder.loading = true;
+
+    m_entries.push_front(placeholder);
+    m_index[key] = m_entries.begin();
+
+    lock.unlock();
+
+    std::pair<globjects::Referenced *, size_t> loaded;
+
+    try
+    {
+        loaded = load();
+    }
+    catch (...)
+    {
+        // Release the placeholder, so that waiting and later requests do not block
+        lock.lock();
+
+        m_entries.erase(m_index[key]);
+        m_index.erase(key);
+
+        m_loaded.notify_all();
+
+        throw;
+    }
+
+    lock.lock();
+
+    // Entries that are loading are neither evicted nor cleared
+    const auto entry = m_index[key];
+    Resource resource(loaded.first);
+
+    if (resource)
+    {
+        entry->resource = resource;
+        entry->bytes = loaded.second;
+        entry->loading = false;
+
+        m_bytes += entry->bytes;
+        m_peakBytes = std::max(m_peakBytes, m_bytes);
+
+        evict();
+    }
+    else
+    {
+        m_entries.erase(entry);
+        m_index.erase(key);
+    }
+
+    m_loaded.notify_all();
+
+    return resource;
+}
+
+bool ResourceCache::contains(const std::string & key) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto it = m_index.find(key);
+
+    return it != m_index.end() && !it->second->loading;
+}
+
+void ResourceCache::trim()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    evict();
+}
+
+void ResourceCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+        if (it->loading)
+        {
+            ++it;
+            continue;
+        }
+
+        m_bytes -= it->bytes;
+        m_index.erase(it->key);
+        it = m_entries.erase(it);
+    }
+
+    m_peakBytes = m_bytes;
+    m_hits = 0;
+    m_misses = 0;
+    m_evictions = 0;
+}
+
+void ResourceCache::writeSummary(std::ostream & stream) const
+{
+    const Statistics stats = statistics();
+    const size_t requests = stats.hits + stats.misses;
+
+    const auto flags = stream.flags();
+    const auto precision = stream.precision();
+
+    stream << std::fixed << std::setprecision(1);
+    stream << "Resources: " << stats.entries
+           << ", size " << toKibibytes(stats.bytes) << " KiB (peak " << toKibibytes(stats.peakBytes)
+           << " KiB, budget " << toKibibytes(budget()) << " KiB)" << std::endl;
+    stream << "Requests: " << requests << ", hits " << stats.hits << " ("
+           << (requests > 0 ? 100.0 * stats.hits / requests : 0.0) << "%), misses " << stats.misses
+           << ", evictions " << stats.evictions << std::endl;
+
+    stream.flags(flags);
+    stream.precision(precision);
+}
+
+void ResourceCache::evict()
+{
+    // Release least recently used resources first
+    for (auto it = m_entries.end(); it != m_entries.begin() && m_bytes > m_budget;)
+    {
+        --it;
+
+        // Resources in use elsewhere would not be freed
+        if (it->loading || it->resource->refCounter() > 1)
+            continue;
+
+        m_bytes -= it->bytes;
+        m_index.erase(it->key);
+        it = m_entries.erase(it);
+
+        ++m_evictions;
+    }
+}
+
+
+} // namespace gloperate
@@ -2,21 +2,163 @@
 #include <gloperate/resources/ResourceManager.h>
 
 #include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <sys/stat.h>
+
+#include <gloperate/base/make_unique.hpp>
+#include <gloperate/base/ThreadPool.h>
 
 #include <gloperate/resources/Loader.h>
+#include <gloperate/resources/LoadRequest.h>
 #include <gloperate/resources/Storer.h>
  
 
+namespace
+{
+
+
+// Enough for the signatures of common file formats
+const size_t s_contentHeaderSize = 256;
+
+
+/**
+*  @brief
+*    Get the extensions of a list of file types, e.g., "*.png *.jpg"
+*/
+std::vector<std::string> extensionsFromTypes(const std::string & types)
+{
+    std::vector<std::string> extensions;
+
+    // Some libraries separate types by semicolons
+    std::string separatedTypes = types;
+    std::replace(separatedTypes.begin(), separatedTypes.end(), ';', ' ');
+
+    std::istringstream stream(separatedTypes);
+    std::string pattern;
+
+    while (stream >> pattern) {
+        if (pattern.size() > 2 && pattern.compare(0, 2, "*.") == 0 && pattern != "*.*") {
+            std::string ext = pattern.substr(2);
+            std::transform(ext.begin(), ext.end(), ext.begin(), tolower);
+            extensions.push_back(ext);
+        }
+    }
+
+    return extensions;
+}
+
+std::vector<char> readContentHeader(const std::string & filename)
+{
+    std::vector<char> header(s_contentHeaderSize);
+
+    std::ifstream stream(filename, std::ios::in | std::ios::binary);
+    stream.read(header.data(), header.size());
+    header.resize(static_cast<size_t>(stream.gcount()));
+
+    return header;
+}
+
+gloperate::AbstractLoader * findLoaderByContent(const std::vector<gloperate::AbstractLoader *> & loaders, const std::string & filename)
+{
+    const std::vector<char> header = readContentHeader(filename);
+
+    if (header.empty()) {
+        return nullptr;
+    }
+
+    for (gloperate::AbstractLoader * loader : loaders) {
+        if (loader->canLoadContent(header.data(), header.size())) {
+            return loader;
+        }
+    }
+
+    return nullptr;
+}
+
+
+std::string canonicalPath(const std::string & filename)
+{
+#if defined(_WIN32)
+    char path[_MAX_PATH];
+    return _fullpath(path, filename.c_str(), _MAX_PATH) ? std::string(path) : filename;
+#else
+    char path[PATH_MAX];
+    return realpath(filename.c_str(), path) ? std::string(path) : filename;
+#endif
+}
+
+long long modificationTime(const std::string & filename)
+{
+#if defined(_WIN32)
+    struct _stat64 status;
+    return _stat64(filename.c_str(), &status) == 0 ? static_cast<long long>(status.st_mtime) : 0;
+#else
+    struct stat status;
+    return stat(filename.c_str(), &status) == 0 ? static_cast<long long>(status.st_mtime) : 0;
+#endif
+}
+
+void writeVariant(std::ostream & stream, const reflectionzeug::Variant & variant)
+{
+    if (const reflectionzeug::VariantMap * map = variant.asMap()) {
+        stream << "{";
+        for (const auto & entry : *map) {
+            stream << entry.first.size() << ":" << entry.first << "=";
+            writeVariant(stream, entry.second);
+            stream << ",";
+        }
+        stream << "}";
+    } else if (const reflectionzeug::VariantArray * array = variant.asArray()) {
+        stream << "[";
+        for (const auto & element : *array) {
+            writeVariant(stream, element);
+            stream << ",";
+        }
+        stream << "]";
+    } else {
+        // Length prefix keeps values containing separators unambiguous
+        const std::string value = variant.value<std::string>();
+        stream << value.size() << ":" << value;
+    }
+}
+
+
+} // namespace
+
+
 namespace gloperate
 {
 
 
-ResourceManager::ResourceManager()
+ResourceManager::ResourceManager(unsigned int numLoadingThreads)
+: m_numLoadingThreads(numLoadingThreads)
 {
 }
 
 ResourceManager::~ResourceManager()
 {
+    // Cancel asynchronous requests, requests that are loading already are waited for
+    std::vector<std::shared_ptr<AbstractLoadRequest>> requests;
+    {
+        std::lock_guard<std::mutex> lock(m_requestMutex);
+        requests = m_requests;
+    }
+
+    for (const auto & request : requests) {
+        request->cancel();
+    }
+
+    m_loadingThreads.reset();
+
+    // Resources that do not need the context may still have been loaded
+    m_uploads.clear();
+    m_requests.clear();
+
     // Release loaders
     for (AbstractLoader * loader : m_loaders) {
         delete loader;
@@ -44,12 +186,193 @@ void ResourceManager::addLoader(AbstractLoader * loader)
 {
     // Add loader to list
     m_loaders.push_back(loader);
+
+    // Index loader by the extensions it lists and supports
+    const size_t typeId = loader->resourceTypeId();
+    m_loadersByType[typeId].push_back(loader);
+
+    for (const std::string & ext : extensionsFromTypes(loader->allLoadingTypes())) {
+        if (!loader->canLoad(ext)) {
+            continue;
+        }
+
+        auto & loaders = m_loaderIndex[IndexKey(typeId, ext)];
+        if (std::find(loaders.begin(), loaders.end(), loader) == loaders.end()) {
+            loaders.push_back(loader);
+        }
+    }
 }
 
 void ResourceManager::addStorer(AbstractStorer * storer)
 {
     // Add storer to list
     m_storers.push_back(storer);
+
+    // Index storer by the extensions it lists and supports
+    const size_t typeId = storer->resourceTypeId();
+    m_storersByType[typeId].push_back(storer);
+
+    for (const std::string & ext : extensionsFromTypes(storer->allStoringTypes())) {
+        if (!storer->canStore(ext)) {
+            continue;
+        }
+
+        auto & storers = m_storerIndex[IndexKey(typeId, ext)];
+        if (std::find(storers.begin(), storers.end(), storer) == storers.end()) {
+            storers.push_back(storer);
+        }
+    }
+}
+
+ResourceCache & ResourceManager::cache()
+{
+    return m_cache;
+}
+
+const ResourceCache & ResourceManager::cache() const
+{
+    return m_cache;
+}
+
+size_t ResourceManager::processUploads(ChronoTimer::Duration budget)
+{
+    ChronoTimer timer;
+    size_t numUploads = 0;
+
+    while (true) {
+        std::shared_ptr<AbstractLoadRequest> request;
+        {
+            std::lock_guard<std::mutex> lock(m_requestMutex);
+
+            if (m_uploads.empty()) {
+                break;
+            }
+
+            request = m_uploads.front();
+            m_uploads.pop_front();
+        }
+
+        // Canceled requests are skipped by upload()
+        request->upload();
+        ++numUploads;
+
+        if (budget > ChronoTimer::Duration::zero() && timer.elapsed() >= budget) {
+            break;
+        }
+    }
+
+    // Release cached resources that were dropped since the last frame
+    m_cache.trim();
+
+    return numUploads;
+}
+
+bool ResourceManager::hasPendingRequests() const
+{
+    std::lock_guard<std::mutex> lock(m_requestMutex);
+
+    return std::any_of(m_requests.begin(), m_requests.end(), [](const std::shared_ptr<AbstractLoadRequest> & request)
+    {
+        return !request->isDone();
+    });
+}
+
+void ResourceManager::enqueue(const std::shared_ptr<AbstractLoadRequest> & request)
+{
+    std::lock_guard<std::mutex> lock(m_requestMutex);
+
+    if (!m_loadingThreads) {
+        m_loadingThreads = make_unique<ThreadPool>(m_numLoadingThreads);
+    }
+
+    // Forget requests that are done
+    m_requests.erase(std::remove_if(m_requests.begin(), m_requests.end(), [](const std::shared_ptr<AbstractLoadRequest> & request)
+    {
+        return request->isDone();
+    }), m_requests.end());
+
+    m_requests.push_back(request);
+
+    m_loadingThreads->execute([this, request]()
+    {
+        if (request->load()) {
+            // Marked and queued at once, so processUploads() finds every request that is reported as uploading
+            std::lock_guard<std::mutex> lock(m_requestMutex);
+
+            if (request->markUploading()) {
+                m_uploads.push_back(request);
+            }
+        }
+    });
+}
+
+AbstractLoader * ResourceManager::findLoader(size_t typeId, const std::string & filename) const
+{
+    const IndexKey key(typeId, getFileExtension(filename));
+
+    // Look up loaders listing the extension
+    const auto it = m_loaderIndex.find(key);
+    if (it != m_loaderIndex.end()) {
+        const std::vector<AbstractLoader *> & loaders = it->second;
+        if (loaders.size() == 1) {
+            return loaders.front();
+        }
+
+        // Ambiguous extension, check content of the file
+        AbstractLoader * loader = findLoaderByContent(loaders, filename);
+        return loader ? loader : loaders.front();
+    }
+
+    const auto typeIt = m_loadersByType.find(typeId);
+    if (typeIt == m_loadersByType.end()) {
+        return nullptr;
+    }
+
+    // Loaders can support extensions they do not list
+    for (AbstractLoader * loader : typeIt->second) {
+        if (loader->canLoad(key.second)) {
+            return loader;
+        }
+    }
+
+    // Unknown or missing extension, check content of the file
+    return findLoaderByContent(typeIt->second, filename);
+}
+
+AbstractStorer * ResourceManager::findStorer(size_t typeId, const std::string & filename) const
+{
+    const IndexKey key(typeId, getFileExtension(filename));
+
+    // Look up storers listing the extension
+    const auto it = m_storerIndex.find(key);
+    if (it != m_storerIndex.end()) {
+        return it->second.front();
+    }
+
+    const auto typeIt = m_storersByType.find(typeId);
+    if (typeIt == m_storersByType.end()) {
+        return nullptr;
+    }
+
+    // Storers can support extensions they do not list
+    for (AbstractStorer * storer : typeIt->second) {
+        if (storer->canStore(key.second)) {
+            return storer;
+        }
+    }
+
+    return nullptr;
+}
+
+std::string ResourceManager::cacheKey(size_t typeId, const std::string & filename, const reflectionzeug::Variant & options) const
+{
+    const std::string path = canonicalPath(filename);
+
+    std::stringstream key;
+    key << typeId << "|" << path.size() << ":" << path << "|" << modificationTime(path) << "|";
+    writeVariant(key, options);
+
+    return key.str();
 }
 
 std::string ResourceManager::getFileExtension(const std::string & filename) const
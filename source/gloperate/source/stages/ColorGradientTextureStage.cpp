@@ -11,6 +11,8 @@ ColorGradientTextureStage::ColorGradientTextureStage()
     addInput("textureWidth", textureWidth);
 
     addOutput("gradientTexture", gradientTexture);
+
+    setRequiresContext(true);
 }
 
 ColorGradientTextureStage::~ColorGradientTextureStage()
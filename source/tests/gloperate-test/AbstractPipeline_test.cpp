@@ -1,11 +1,61 @@
 
 #include <gmock/gmock.h>
 
-#include <iostream>
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+#include <gloperate/pipeline/AbstractData.h>
+#include <gloperate/pipeline/AsyncStage.h>
+#include <gloperate/pipeline/BatchEvaluation.h>
+#include <gloperate/pipeline/FeedbackSlot.h>
+#include <gloperate/pipeline/HistoryData.h>
+#include <gloperate/pipeline/MemoryTracker.h>
+#include <gloperate/pipeline/ParameterRecorder.h>
+#include <gloperate/pipeline/ParameterReplayer.h>
+#include <gloperate/pipeline/PipelineAnalysis.h>
+#include <gloperate/pipeline/PipelineTransaction.h>
+#include <gloperate/pipeline/StageProfiler.h>
 
 #include "TestPipeline.hpp"
 
 
+namespace
+{
+    std::vector<int> outputValues(const AbstractPipeline & pipeline)
+    {
+        std::vector<int> values;
+
+        for (auto stage : pipeline.stages())
+        {
+            for (auto output : stage->outputs())
+            {
+                values.push_back(static_cast<Data<int> *>(output)->data());
+            }
+        }
+
+        return values;
+    }
+
+    bool isSorted(const AbstractPipeline & pipeline)
+    {
+        const auto & stages = pipeline.stages();
+
+        for (size_t i = 0; i < stages.size(); ++i)
+        {
+            for (size_t j = i + 1; j < stages.size(); ++j)
+            {
+                if (stages[i]->requires(stages[j], false))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+
 using namespace gloperate;
 
 
@@ -18,9 +68,797 @@ public:
 };
 
 
+class ParameterPipeline : public AbstractPipeline
+{
+public:
+    ParameterPipeline()
+    :   parameter(1)
+    ,   stage0(new DummyStage("stage0", { "input0" }, { "output0" }))
+    ,   stage1(new DummyStage("stage1", { "input0" }, { "output0" }))
+    ,   stage2(new DummyStage("stage2", { "input0" }, { "output0" }))
+    {
+        addParameter("parameter", &parameter);
+
+        stage0->inputs.at("input0") = parameter;
+        stage1->inputs.at("input0") = stage0->outputs.at("output0");
+        stage2->inputs.at("input0") = other;
+
+        addStages(stage2, stage1, stage0);
+    }
+
+public:
+    Data<int> parameter;
+    Data<int> other;
+
+    DummyStage * stage0;
+    DummyStage * stage1;
+    DummyStage * stage2;
+};
+
+
+class LayeredPipeline : public AbstractPipeline
+{
+public:
+    LayeredPipeline(size_t numLayers, size_t layerSize)
+    {
+        // The source has no inputs, so all stages are processed on every execution
+        auto source = new DummyStage("source", {}, { "output0" });
+        addStage(source);
+
+        std::vector<DummyStage *> previousLayer(layerSize, source);
+
+        for (size_t layer = 0; layer < numLayers; ++layer)
+        {
+            for (size_t i = 0; i < layerSize; ++i)
+            {
+                auto stage = new DummyStage("stage" + std::to_string(layer * layerSize + i), { "input0" }, { "output0" });
+                stage->inputs.at("input0") = previousLayer[i]->outputs.at("output0");
+                addStage(stage);
+
+                previousLayer[i] = stage;
+            }
+        }
+    }
+};
+
+
+class AccumulatingStage : public AbstractStage
+{
+public:
+    AccumulatingStage()
+    :   AbstractStage("accumulating")
+    {
+        addInput("input", input);
+        addFeedbackInput("previous", previous);
+        addOutput("sum", sum);
+
+        previous = sum;
+    }
+
+protected:
+    virtual void process() override
+    {
+        sum.data() = previous.previous(1) + input.data();
+
+        invalidateOutputs();
+    }
+
+public:
+    InputSlot<int> input;
+    FeedbackSlot<int, 2> previous;
+    HistoryData<int, 2> sum;
+};
+
+
+class VectorStage : public AbstractStage
+{
+public:
+    VectorStage()
+    :   AbstractStage("vector")
+    {
+        addInput("count", count);
+        addOutput("values", values);
+    }
+
+protected:
+    virtual void process() override
+    {
+        values.data().assign(count.data(), 0);
+        values.data().shrink_to_fit();
+
+        invalidateOutputs();
+    }
+
+public:
+    InputSlot<int> count;
+    Data<std::vector<int>> values;
+};
+
+
+class AsyncDummyStage : public AsyncStage
+{
+public:
+    AsyncDummyStage()
+    :   AsyncStage("async")
+    ,   value(0)
+    {
+        addInput("input", input);
+        addOutput("output", output);
+    }
+
+    virtual ~AsyncDummyStage()
+    {
+        wait();
+    }
+
+protected:
+    virtual void prepare() override
+    {
+        value = input.data();
+    }
+
+    virtual void processAsync() override
+    {
+        output.back() = value + 1;
+        output.publish();
+    }
+
+public:
+    InputSlot<int> input;
+    BufferedData<int> output;
+    int value;
+};
+
+
 TEST_F(AbstractPipeline_test, PipelineIsSortable)
 {
     TestPipeline pipeline;
     pipeline.initialize();
     ASSERT_TRUE(pipeline.isInitialized());
 }
+
+TEST_F(AbstractPipeline_test, ParallelExecutionMatchesSequential)
+{
+    TestPipeline sequential;
+    sequential.initialize();
+    sequential.execute();
+
+    TestPipeline parallel;
+    parallel.setParallelExecution(true, 4);
+    parallel.initialize();
+    parallel.execute();
+
+    ASSERT_TRUE(parallel.parallelExecution());
+    ASSERT_EQ(outputValues(sequential), outputValues(parallel));
+}
+
+TEST_F(AbstractPipeline_test, UnchangedPipelineProcessesNothing)
+{
+    ParameterPipeline pipeline;
+    pipeline.initialize();
+    pipeline.execute();
+
+    ASSERT_EQ(1, pipeline.stage0->processCount);
+    ASSERT_EQ(1, pipeline.stage1->processCount);
+    ASSERT_EQ(1, pipeline.stage2->processCount);
+
+    pipeline.execute();
+
+    ASSERT_EQ(1, pipeline.stage0->processCount);
+    ASSERT_EQ(1, pipeline.stage1->processCount);
+    ASSERT_EQ(1, pipeline.stage2->processCount);
+}
+
+TEST_F(AbstractPipeline_test, InvalidationProcessesConsumersOnly)
+{
+    ParameterPipeline pipeline;
+    pipeline.initialize();
+    pipeline.execute();
+
+    pipeline.parameter.setData(2);
+    pipeline.execute();
+
+    ASSERT_EQ(2, pipeline.stage0->processCount);
+    ASSERT_EQ(2, pipeline.stage1->processCount);
+    ASSERT_EQ(1, pipeline.stage2->processCount);
+    ASSERT_EQ(4, pipeline.stage1->outputs.at("output0").data());
+}
+
+TEST_F(AbstractPipeline_test, TransactionDeliversInvalidationsOnce)
+{
+    ParameterPipeline pipeline;
+    pipeline.initialize();
+    pipeline.execute();
+
+    int invalidations = 0;
+    pipeline.parameter.invalidated.connect([&invalidations]() { ++invalidations; });
+
+    {
+        PipelineTransaction transaction(pipeline);
+
+        pipeline.parameter.setData(2);
+        pipeline.parameter.setData(3);
+
+        ASSERT_TRUE(pipeline.isUpdating());
+        ASSERT_EQ(0, invalidations);
+        ASSERT_FALSE(pipeline.stage0->isDirty());
+    }
+
+    ASSERT_EQ(1, invalidations);
+    ASSERT_TRUE(pipeline.stage0->isDirty());
+
+    pipeline.execute();
+
+    ASSERT_EQ(2, pipeline.stage0->processCount);
+    ASSERT_EQ(5, pipeline.stage1->outputs.at("output0").data());
+}
+
+TEST_F(AbstractPipeline_test, EvaluateProcessesContributingStagesOnly)
+{
+    ParameterPipeline pipeline;
+    pipeline.initialize();
+    pipeline.execute();
+
+    pipeline.parameter.setData(2);
+    pipeline.other.setData(2);
+    pipeline.evaluate(&pipeline.stage1->outputs.at("output0"));
+
+    ASSERT_EQ(2, pipeline.stage0->processCount);
+    ASSERT_EQ(2, pipeline.stage1->processCount);
+    ASSERT_EQ(1, pipeline.stage2->processCount);
+
+    pipeline.execute();
+
+    ASSERT_EQ(2, pipeline.stage0->processCount);
+    ASSERT_EQ(2, pipeline.stage1->processCount);
+    ASSERT_EQ(2, pipeline.stage2->processCount);
+}
+
+TEST_F(AbstractPipeline_test, ReconnectingSlotReordersStages)
+{
+    ParameterPipeline pipeline;
+    pipeline.initialize();
+    pipeline.execute();
+
+    pipeline.stage0->inputs.at("input0") = pipeline.stage2->outputs.at("output0");
+    pipeline.stage2->inputs.at("input0") = pipeline.parameter;
+
+    ASSERT_TRUE(isSorted(pipeline));
+
+    pipeline.execute();
+
+    ASSERT_EQ(4, pipeline.stage1->outputs.at("output0").data());
+}
+
+TEST_F(AbstractPipeline_test, SortingKeepsOrderOfIndependentStages)
+{
+    ParameterPipeline pipeline;
+
+    auto stage3 = new DummyStage("stage3", { "input0" }, { "output0" });
+    stage3->inputs.at("input0") = pipeline.other;
+    pipeline.addStage(stage3);
+
+    // stage2 and stage1 become ready after stage0, but are still placed before stage3
+    pipeline.stage2->inputs.at("input0") = pipeline.stage0->outputs.at("output0");
+    pipeline.initialize();
+
+    const std::vector<AbstractStage *> expected = { pipeline.stage0, pipeline.stage2, pipeline.stage1, stage3 };
+    ASSERT_EQ(expected, pipeline.stages());
+}
+
+TEST_F(AbstractPipeline_test, CompiledExecutionMatchesDynamic)
+{
+    TestPipeline dynamic;
+    dynamic.initialize();
+
+    TestPipeline compiled;
+    compiled.initialize();
+
+    ASSERT_TRUE(compiled.compile());
+
+    for (int i = 0; i < 3; ++i)
+    {
+        dynamic.execute();
+        compiled.execute();
+    }
+
+    ASSERT_EQ(outputValues(dynamic), outputValues(compiled));
+
+    for (size_t i = 0; i < dynamic.stages().size(); ++i)
+    {
+        ASSERT_EQ(static_cast<DummyStage *>(dynamic.stages()[i])->processCount, static_cast<DummyStage *>(compiled.stages()[i])->processCount);
+    }
+}
+
+TEST_F(AbstractPipeline_test, CompiledPipelineFollowsTopologyChanges)
+{
+    ParameterPipeline pipeline;
+    pipeline.initialize();
+    pipeline.compile();
+    pipeline.execute();
+
+    pipeline.stage0->inputs.at("input0") = pipeline.stage2->outputs.at("output0");
+    pipeline.stage2->inputs.at("input0") = pipeline.parameter;
+
+    ASSERT_TRUE(pipeline.isCompiled());
+    ASSERT_TRUE(isSorted(pipeline));
+
+    pipeline.execute();
+
+    ASSERT_EQ(4, pipeline.stage1->outputs.at("output0").data());
+
+    pipeline.parameter.setData(2);
+    pipeline.execute();
+
+    ASSERT_EQ(3, pipeline.stage0->processCount);
+    ASSERT_EQ(5, pipeline.stage1->outputs.at("output0").data());
+}
+
+TEST_F(AbstractPipeline_test, CompiledLayeredPipelineMatchesDynamic)
+{
+    // Timings of compiled execution are reported by gloperate-run --compiled
+    LayeredPipeline dynamic(4, 50);
+    dynamic.initialize();
+
+    LayeredPipeline compiled(4, 50);
+    compiled.initialize();
+
+    ASSERT_TRUE(compiled.compile());
+
+    for (int i = 0; i < 5; ++i)
+    {
+        dynamic.execute();
+        compiled.execute();
+
+        ASSERT_EQ(outputValues(dynamic), outputValues(compiled));
+    }
+
+    for (size_t i = 0; i < dynamic.stages().size(); ++i)
+    {
+        ASSERT_EQ(5, static_cast<DummyStage *>(compiled.stages()[i])->processCount);
+        ASSERT_EQ(static_cast<DummyStage *>(dynamic.stages()[i])->processCount, static_cast<DummyStage *>(compiled.stages()[i])->processCount);
+    }
+}
+
+TEST_F(AbstractPipeline_test, AddingStageKeepsOrder)
+{
+    ParameterPipeline pipeline;
+    pipeline.initialize();
+    pipeline.execute();
+
+    auto stage3 = new DummyStage("stage3", { "input0" }, { "output0" });
+    stage3->inputs.at("input0") = pipeline.parameter;
+    pipeline.stage0->inputs.at("input0") = stage3->outputs.at("output0");
+    pipeline.addStage(stage3);
+
+    ASSERT_TRUE(isSorted(pipeline));
+
+    pipeline.execute();
+
+    ASSERT_EQ(1, stage3->processCount);
+    ASSERT_EQ(4, pipeline.stage1->outputs.at("output0").data());
+}
+
+TEST_F(AbstractPipeline_test, CyclicPipelineIsNotSortable)
+{
+    ParameterPipeline pipeline;
+    pipeline.stage0->inputs.at("input0") = pipeline.stage1->outputs.at("output0");
+    pipeline.initialize();
+
+    ASSERT_FALSE(pipeline.isInitialized());
+}
+
+TEST_F(AbstractPipeline_test, FrameBudgetCarriesDeferrableStagesOver)
+{
+    ParameterPipeline pipeline;
+    pipeline.stage2->setDeferrable(true);
+    pipeline.setFrameBudget(std::chrono::nanoseconds(1));
+    pipeline.initialize();
+    pipeline.execute();
+
+    ASSERT_EQ(1, pipeline.stage0->processCount);
+    ASSERT_EQ(1, pipeline.stage1->processCount);
+    ASSERT_EQ(0, pipeline.stage2->processCount);
+    ASSERT_EQ(1u, pipeline.budgetUsage().carriedOver);
+
+    pipeline.setFrameBudget(std::chrono::seconds(10));
+    pipeline.execute();
+
+    ASSERT_EQ(1, pipeline.stage0->processCount);
+    ASSERT_EQ(1, pipeline.stage2->processCount);
+    ASSERT_EQ(1u, pipeline.budgetUsage().processedDeferred);
+    ASSERT_EQ(0u, pipeline.budgetUsage().carriedOver);
+}
+
+TEST_F(AbstractPipeline_test, FrameBudgetCountsProcessedStagesOnly)
+{
+    for (bool compiled : { false, true })
+    {
+        ParameterPipeline pipeline;
+        pipeline.stage1->setDeferrable(true);
+        pipeline.stage2->setDeferrable(true);
+
+        // Not usable, so it stays dirty without being processed
+        auto unconnected = new DummyStage("unconnected", { "input0" }, { "output0" });
+        unconnected->setDeferrable(true);
+        pipeline.addStage(unconnected);
+
+        pipeline.setFrameBudget(std::chrono::seconds(10));
+        pipeline.initialize();
+
+        if (compiled)
+            pipeline.compile();
+
+        pipeline.execute();
+
+        ASSERT_EQ(1, pipeline.stage1->processCount);
+        ASSERT_EQ(1, pipeline.stage2->processCount);
+        ASSERT_EQ(0, unconnected->processCount);
+        ASSERT_EQ(2u, pipeline.budgetUsage().processedDeferred);
+        ASSERT_EQ(1u, pipeline.budgetUsage().carriedOver);
+    }
+}
+
+TEST_F(AbstractPipeline_test, FeedbackSlotReadsPreviousValues)
+{
+    AbstractPipeline pipeline;
+    Data<int> parameter(1);
+    auto stage = new AccumulatingStage;
+    stage->input = parameter;
+    pipeline.addParameter("parameter", &parameter);
+    pipeline.addStage(stage);
+    pipeline.initialize();
+
+    for (int i = 0; i < 3; ++i)
+    {
+        pipeline.execute();
+    }
+
+    ASSERT_EQ(3, stage->sum.data());
+    ASSERT_EQ(2, stage->previous.previous(1));
+    ASSERT_EQ(1, stage->previous.previous(2));
+    ASSERT_EQ(2u, stage->previous.historySize());
+}
+
+TEST_F(AbstractPipeline_test, MemoryReportKeepsPeakSizes)
+{
+    AbstractPipeline pipeline;
+    Data<int> count(1000);
+    auto stage = new VectorStage;
+    stage->count = count;
+    pipeline.addParameter("count", &count);
+    pipeline.addStage(stage);
+    pipeline.initialize();
+    pipeline.setMemoryTracking(true);
+    pipeline.execute();
+
+    count = 10;
+    pipeline.execute();
+
+    const auto report = pipeline.memoryReport();
+    const auto smallSize = sizeof(std::vector<int>) + 10 * sizeof(int);
+    const auto largeSize = sizeof(std::vector<int>) + 1000 * sizeof(int);
+
+    ASSERT_EQ(1u, report.parameters.size());
+    ASSERT_TRUE(report.parameters[0].connected);
+    ASSERT_EQ(1u, report.stages.size());
+    ASSERT_EQ(1u, report.stages[0].outputs.size());
+    ASSERT_FALSE(report.stages[0].outputs[0].connected);
+    ASSERT_EQ(smallSize, report.stages[0].outputs[0].bytes);
+    ASSERT_EQ(largeSize, report.stages[0].outputs[0].peakBytes);
+    ASSERT_EQ(sizeof(int) + smallSize, report.totalBytes);
+    ASSERT_EQ(sizeof(int) + largeSize, report.peakBytes);
+
+    std::stringstream summary;
+    report.writeSummary(summary);
+    ASSERT_NE(std::string::npos, summary.str().find("values"));
+
+    pipeline.memoryTracker()->reset();
+    ASSERT_EQ(sizeof(int) + smallSize, pipeline.memoryReport().peakBytes);
+}
+
+TEST_F(AbstractPipeline_test, ReplayedParametersFollowRecording)
+{
+    std::stringstream log;
+    std::vector<int> recordedOutputs;
+
+    {
+        ParameterPipeline pipeline;
+        pipeline.initialize();
+
+        ParameterRecorder recorder(log);
+        recorder.addParameter("parameter", pipeline.parameter);
+        recorder.start();
+
+        for (int i = 0; i < 3; ++i)
+        {
+            pipeline.parameter = 10 * i;
+            pipeline.parameter = 10 * i + 1;
+
+            recorder.frame();
+            pipeline.execute();
+
+            recordedOutputs.push_back(pipeline.stage1->outputs.at("output0").data());
+        }
+
+        recorder.stop();
+
+        ASSERT_EQ(3u, recorder.frames());
+        ASSERT_EQ(7u, recorder.changes());
+    }
+
+    ParameterPipeline pipeline;
+    pipeline.initialize();
+
+    ParameterReplayer replayer(log);
+    replayer.addParameter("parameter", pipeline.parameter);
+    ASSERT_TRUE(replayer.isValid());
+
+    std::vector<int> replayedParameters;
+    std::vector<int> replayedOutputs;
+
+    while (replayer.nextFrame())
+    {
+        replayedParameters.push_back(pipeline.parameter.data());
+
+        pipeline.execute();
+        replayedOutputs.push_back(pipeline.stage1->outputs.at("output0").data());
+    }
+
+    ASSERT_EQ(std::vector<int>({ 1, 11, 21 }), replayedParameters);
+    ASSERT_EQ(recordedOutputs, replayedOutputs);
+    ASSERT_EQ(7u, replayer.changes());
+    ASSERT_EQ(0u, replayer.skippedChanges());
+    ASSERT_TRUE(replayer.atEnd());
+
+    std::stringstream invalidLog("not a parameter log");
+    ASSERT_FALSE(ParameterReplayer(invalidLog).isValid());
+
+    // Parameter record with an index of 2^62, followed by a frame
+    std::stringstream corruptLog(std::string("GLPL\x01\x01\x80\x80\x80\x80\x80\x80\x80\x80\x40\x01x\x03\x00", 18));
+    ParameterReplayer corruptReplayer(corruptLog);
+    ASSERT_TRUE(corruptReplayer.isValid());
+    ASSERT_FALSE(corruptReplayer.nextFrame());
+    ASSERT_TRUE(corruptReplayer.atEnd());
+}
+
+TEST_F(AbstractPipeline_test, ProfilerCountsExecutionsAndSkips)
+{
+    ParameterPipeline pipeline;
+    pipeline.initialize();
+    pipeline.setProfiling(true, 2);
+    pipeline.execute();
+
+    pipeline.parameter.invalidate();
+    pipeline.execute();
+    pipeline.execute();
+
+    auto statistics = pipeline.profiler()->statistics();
+    ASSERT_EQ(3u, statistics.size());
+
+    for (const auto & stats : statistics)
+    {
+        const auto invocations = stats.stageName == "stage2" ? 1u : 2u;
+
+        ASSERT_EQ(invocations, stats.invocations);
+        ASSERT_EQ(3u - invocations, stats.skips);
+    }
+
+    ASSERT_EQ(2u, pipeline.profiler()->frames().size());
+}
+
+TEST_F(AbstractPipeline_test, ProfilerWritesTraceOfRecentFrames)
+{
+    ParameterPipeline pipeline;
+    pipeline.initialize();
+    pipeline.setProfiling(true);
+    pipeline.execute();
+
+    std::stringstream trace;
+    pipeline.writeTrace(trace);
+
+    ASSERT_EQ(0u, trace.str().find("{\"traceEvents\":["));
+    ASSERT_NE(std::string::npos, trace.str().find("\"name\":\"stage1\""));
+    ASSERT_NE(std::string::npos, trace.str().find("\"name\":\"Frame\""));
+
+    pipeline.setProfiling(false);
+    ASSERT_EQ(nullptr, pipeline.profiler());
+}
+
+TEST_F(AbstractPipeline_test, AnalysisFindsCriticalPath)
+{
+    LayeredPipeline pipeline(2, 2);
+
+    // The chain through stage0 and stage2 dominates the chain through stage1 and stage3
+    std::unordered_map<const AbstractStage *, PipelineAnalysis::Duration> times;
+    std::map<std::string, const AbstractStage *> stages;
+
+    for (auto stage : pipeline.stages())
+    {
+        const bool heavy = stage->name() == "stage0" || stage->name() == "stage2";
+
+        times[stage] = std::chrono::milliseconds(heavy ? 4 : 1);
+        stages[stage->name()] = stage;
+    }
+
+    PipelineAnalysis analysis(pipeline, times);
+    ASSERT_TRUE(analysis.isValid());
+
+    ASSERT_EQ(std::chrono::milliseconds(11), analysis.work());
+    ASSERT_EQ(std::chrono::milliseconds(9), analysis.criticalPathLength());
+    ASSERT_EQ(std::vector<const AbstractStage *>({ stages["source"], stages["stage0"], stages["stage2"] }), analysis.criticalPath());
+    ASSERT_EQ(std::vector<const AbstractStage *>({ stages["source"] }), analysis.serializingStages());
+
+    ASSERT_EQ(analysis.work(), analysis.scheduleLength(1));
+    ASSERT_EQ(analysis.criticalPathLength(), analysis.scheduleLength(2));
+    ASSERT_DOUBLE_EQ(11.0 / 9.0, analysis.speedup(4));
+
+    std::stringstream dot;
+    analysis.writeDot(dot);
+
+    ASSERT_EQ(0u, dot.str().find("digraph pipeline {"));
+    ASSERT_NE(std::string::npos, dot.str().find("stage3\\n1.000 ms\\nslack 6.000 ms"));
+}
+
+TEST_F(AbstractPipeline_test, AsyncStagePublishesAtNextExecution)
+{
+    AbstractPipeline pipeline;
+    Data<int> parameter(1);
+
+    auto async = new AsyncDummyStage;
+    auto consumer = new DummyStage("consumer", { "input0" }, { "output0" });
+
+    async->input = parameter;
+    consumer->inputs.at("input0") = async->output;
+
+    pipeline.addParameter("parameter", &parameter);
+    pipeline.addStages(async, consumer);
+    pipeline.initialize();
+    pipeline.execute();
+
+    // The consumer still reads the initial value
+    async->wait();
+    ASSERT_EQ(0, async->output.data());
+    ASSERT_EQ(1, consumer->outputs.at("output0").data());
+
+    pipeline.execute();
+
+    ASSERT_EQ(2, async->output.data());
+    ASSERT_EQ(3, consumer->outputs.at("output0").data());
+    ASSERT_EQ(2, consumer->processCount);
+
+    // Invalidation while processing restarts the stage after publishing
+    parameter.setData(5);
+    pipeline.execute();
+    parameter.setData(7);
+    pipeline.execute();
+
+    async->wait();
+    pipeline.execute();
+    async->wait();
+    pipeline.execute();
+
+    ASSERT_EQ(8, async->output.data());
+    ASSERT_EQ(9, consumer->outputs.at("output0").data());
+}
+
+TEST_F(AbstractPipeline_test, FindsDataByNameAndType)
+{
+    ParameterPipeline pipeline;
+
+    ASSERT_EQ(&pipeline.parameter, pipeline.findParameter("parameter"));
+    ASSERT_EQ(&pipeline.parameter, pipeline.getParameter<int>());
+    ASSERT_EQ(nullptr, pipeline.getParameter<float>("parameter"));
+
+    ASSERT_EQ(1u, pipeline.findOutputs("stage1_output0").size());
+    ASSERT_EQ(&pipeline.stage1->outputs.at("output0"), pipeline.getOutput<int>("stage1::stage1_output0"));
+    ASSERT_EQ(nullptr, pipeline.getOutput<float>("stage1_output0"));
+    ASSERT_NE(nullptr, pipeline.getOutput<int>());
+
+    // Renaming and adding stages updates the index
+    pipeline.stage1->setName("renamed");
+    ASSERT_EQ(nullptr, pipeline.findOutput("stage1::stage1_output0", TypeToken<int>::id()));
+    ASSERT_EQ(&pipeline.stage1->outputs.at("output0"), pipeline.getOutput<int>("renamed::stage1_output0"));
+
+    auto stage3 = new DummyStage("stage3", {}, { "output0" });
+    pipeline.addStage(stage3);
+    ASSERT_EQ(&stage3->outputs.at("output0"), pipeline.getOutput<int>("stage3_output0"));
+
+    // Renaming parameters updates the index
+    pipeline.parameter.setName("renamedParameter");
+    ASSERT_EQ(nullptr, pipeline.findParameter("parameter"));
+    ASSERT_EQ(nullptr, pipeline.getParameter<int>("parameter"));
+    ASSERT_EQ(&pipeline.parameter, pipeline.findParameter("renamedParameter"));
+    ASSERT_EQ(&pipeline.parameter, pipeline.getParameter<int>("renamedParameter"));
+}
+
+TEST_F(AbstractPipeline_test, MemoizedStageRestoresPreviousOutputs)
+{
+    ParameterPipeline pipeline;
+    pipeline.stage0->setMemoization(true, 2);
+    pipeline.initialize();
+    pipeline.execute();
+
+    pipeline.parameter.setData(2);
+    pipeline.execute();
+    ASSERT_EQ(4, pipeline.stage1->outputs.at("output0").data());
+
+    pipeline.parameter.setData(1);
+    pipeline.execute();
+
+    ASSERT_EQ(2, pipeline.stage0->processCount);
+    ASSERT_EQ(2, pipeline.stage0->outputs.at("output0").data());
+    ASSERT_EQ(3, pipeline.stage1->processCount);
+    ASSERT_EQ(3, pipeline.stage1->outputs.at("output0").data());
+
+    ASSERT_EQ(1u, pipeline.stage0->cache()->hits());
+    ASSERT_EQ(2u, pipeline.stage0->cache()->misses());
+
+    // Least recently used entries are evicted
+    pipeline.parameter.setData(3);
+    pipeline.execute();
+    pipeline.parameter.setData(2);
+    pipeline.execute();
+
+    ASSERT_EQ(4, pipeline.stage0->processCount);
+    ASSERT_EQ(2u, pipeline.stage0->cache()->size());
+}
+
+TEST_F(AbstractPipeline_test, BatchEvaluationProcessesEqualValuesOnce)
+{
+    std::vector<BatchEvaluation::Parameters> variants(4);
+    variants[0].set("parameter", 1);
+    variants[1].set("parameter", 2);
+    variants[2].set("parameter", 1);
+    variants[3].set("parameter", 2);
+
+    BatchEvaluation batch({ "stage1::stage1_output0" });
+
+    ParameterPipeline pipeline;
+    auto results = batch.run(pipeline, variants);
+
+    ASSERT_EQ(4u, results.size());
+    ASSERT_EQ(3, *results[0].get<int>("stage1::stage1_output0"));
+    ASSERT_EQ(4, *results[1].get<int>("stage1::stage1_output0"));
+    ASSERT_EQ(3, *results[2].get<int>("stage1::stage1_output0"));
+    ASSERT_EQ(4, *results[3].get<int>("stage1::stage1_output0"));
+
+    ASSERT_EQ(2, pipeline.stage0->processCount);
+    ASSERT_EQ(0, pipeline.stage2->processCount);
+    ASSERT_EQ(1, pipeline.parameter.data());
+
+    // Distributed over equivalent pipelines
+    ParameterPipeline first;
+    ParameterPipeline second;
+    auto parallelResults = batch.run({ &first, &second }, variants);
+
+    for (size_t i = 0; i < variants.size(); ++i)
+    {
+        ASSERT_EQ(*results[i].get<int>("stage1::stage1_output0"), *parallelResults[i].get<int>("stage1::stage1_output0"));
+    }
+
+    ASSERT_EQ(1, first.stage0->processCount);
+    ASSERT_EQ(1, second.stage0->processCount);
+}
+
+TEST_F(AbstractPipeline_test, BatchEvaluationResetsUnassignedParameters)
+{
+    std::vector<BatchEvaluation::Parameters> variants(2);
+    variants[0].set("parameter", 2);
+    variants[1].set("other", 5);
+
+    BatchEvaluation batch({ "stage1::stage1_output0", "stage2::stage2_output0" });
+
+    ParameterPipeline pipeline;
+    pipeline.addParameter("other", &pipeline.other);
+    auto results = batch.run(pipeline, variants);
+
+    // The second variant uses the initial value of the parameter
+    ASSERT_EQ(4, *results[0].get<int>("stage1::stage1_output0"));
+    ASSERT_EQ(3, *results[1].get<int>("stage1::stage1_output0"));
+    ASSERT_EQ(1, *results[0].get<int>("stage2::stage2_output0"));
+    ASSERT_EQ(6, *results[1].get<int>("stage2::stage2_output0"));
+
+    ASSERT_EQ(1, pipeline.parameter.data());
+    ASSERT_EQ(0, pipeline.other.data());
+}
@@ -46,3 +46,18 @@ TEST_F(AbstractStage_test, Stage2DoesntRequireStage0Recursive)
 {
     ASSERT_TRUE(stage2.requires(&stage0, true));
 }
+
+TEST_F(AbstractStage_test, SharedSlotsFollowOwnSlots)
+{
+    const AbstractStage & stage = stage2;
+    InputSlot<int> extraInput;
+
+    stage2.shareInput(&stage1.inputs["input0"]);
+    stage2.addInput("extra", extraInput);
+
+    ASSERT_EQ(2u, stage.inputs().size());
+    ASSERT_EQ(3u, stage.allInputs().size());
+    ASSERT_EQ(&stage2.inputs["input0"], stage.allInputs()[0]);
+    ASSERT_EQ(&extraInput, stage.allInputs()[1]);
+    ASSERT_EQ(&stage1.inputs["input0"], stage.allInputs()[2]);
+}
@@ -0,0 +1,169 @@
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gloperate/pipeline/Data.h>
+#include <gloperate/pipeline/HistoryData.h>
+#include <gloperate/pipeline/InputSlot.h>
+
+
+using namespace gloperate;
+
+
+class Data_test : public testing::Test
+{
+public:
+    Data_test()
+    :   invalidations(0)
+    {
+        data.invalidated.connect([this]() { ++invalidations; });
+    }
+
+
+protected:
+    Data<std::vector<int>> data;
+    int invalidations;
+};
+
+
+TEST_F(Data_test, SetDataMovesValue)
+{
+    Data<std::unique_ptr<int>> pointer;
+    pointer.setData(std::unique_ptr<int>(new int(42)));
+
+    ASSERT_EQ(42, *pointer.data());
+
+    std::vector<int> values(1000, 1);
+    data.setData(std::move(values));
+
+    ASSERT_EQ(1000u, data->size());
+    ASSERT_EQ(1, invalidations);
+}
+
+TEST_F(Data_test, EmplaceAndModifyInvalidateOnce)
+{
+    data.emplace(3u, 7);
+    ASSERT_EQ(std::vector<int>({ 7, 7, 7 }), data.data());
+
+    data.modify([](std::vector<int> & values) { values.push_back(1); values.push_back(2); });
+    ASSERT_EQ(5u, data->size());
+
+    ASSERT_EQ(2, invalidations);
+}
+
+TEST_F(Data_test, EqualValuesDoNotInvalidate)
+{
+    data.setInvalidateOnlyIfChanged(true);
+
+    data.setData({ 1, 2, 3 });
+    data.setData({ 1, 2, 3 });
+    data = std::vector<int>{ 1, 2, 3 };
+    ASSERT_EQ(1, invalidations);
+
+    data.setData({ 1, 2 });
+    ASSERT_EQ(2, invalidations);
+
+    data.setInvalidateOnlyIfChanged(false);
+    data.setData({ 1, 2 });
+    ASSERT_EQ(3, invalidations);
+}
+
+TEST_F(Data_test, HashDetectsModifications)
+{
+    data.setHashFunction([](const std::vector<int> & values) { return values.size(); });
+    ASSERT_TRUE(data.invalidatesOnlyIfChanged());
+
+    data.modify([](std::vector<int> & values) { values.push_back(1); });
+    data.modify([](std::vector<int> & values) { values[0] = 2; });
+    data.setData({ 3 });
+    ASSERT_EQ(1, invalidations);
+
+    data.data().push_back(4);
+    data.setData({ 3, 4 });
+    ASSERT_EQ(1, invalidations);
+
+    data.setData({ 1, 2, 3 });
+    ASSERT_EQ(2, invalidations);
+}
+
+TEST_F(Data_test, SnapshotsRequireContentHash)
+{
+    data.setData({ 1, 2, 3 });
+
+    // Copying is only trusted for values with a content hash
+    ASSERT_FALSE(data.canSnapshot());
+    ASSERT_EQ(nullptr, data.snapshot());
+
+    data.setHashFunction([](const std::vector<int> & values) { return values.size(); });
+    ASSERT_TRUE(data.canSnapshot());
+
+    const auto snapshot = data.snapshot();
+    ASSERT_NE(nullptr, snapshot);
+
+    data.setData({ 4 });
+    ASSERT_TRUE(data.restore(*snapshot));
+    ASSERT_EQ(std::vector<int>({ 1, 2, 3 }), data.data());
+
+    Data<std::unique_ptr<int>> pointer;
+    ASSERT_FALSE(pointer.canSnapshot());
+
+    Data<int> value(1);
+    ASSERT_TRUE(value.canSnapshot());
+}
+
+TEST_F(Data_test, HistoryKeepsCurrentValueForPartialUpdates)
+{
+    HistoryData<std::vector<int>, 2> history;
+    history.data() = { 1, 2 };
+
+    history.advanceHistory();
+    history.data()[0] = 3;
+
+    ASSERT_EQ(std::vector<int>({ 3, 2 }), history.data());
+    ASSERT_EQ(std::vector<int>({ 1, 2 }), history.previous(1));
+
+    history.advanceHistory();
+    history.data()[1] = 4;
+
+    ASSERT_EQ(std::vector<int>({ 3, 4 }), history.data());
+    ASSERT_EQ(std::vector<int>({ 3, 2 }), history.previous(1));
+    ASSERT_EQ(std::vector<int>({ 1, 2 }), history.previous(2));
+    ASSERT_EQ(2u, history.historySize());
+}
+
+TEST_F(Data_test, SizeInBytesCountsOwnedMemory)
+{
+    data.data().reserve(16);
+    data.data().push_back(1);
+    ASSERT_EQ(sizeof(std::vector<int>) + 16 * sizeof(int), data.sizeInBytes());
+
+    Data<std::vector<std::string>> strings(2, std::string(64, 'x'));
+    const auto stringSize = DataSize<std::string>::sizeInBytes(strings.data().front());
+    ASSERT_LE(sizeof(std::string) + 64, stringSize);
+    ASSERT_EQ(sizeof(std::vector<std::string>) + strings.data().capacity() * stringSize, strings.sizeInBytes());
+
+    Data<int> value(1);
+    ASSERT_EQ(sizeof(int), value.sizeInBytes());
+}
+
+TEST_F(Data_test, TypeTokensIdentifyTypes)
+{
+    ASSERT_EQ("int", TypeToken<int>::name());
+    ASSERT_EQ(typeIdFromName("int"), TypeToken<int>::id());
+    ASSERT_NE(TypeToken<int>::id(), TypeToken<unsigned int>::id());
+    ASSERT_NE(TypeToken<int>::id(), TypeToken<int *>::id());
+
+    ASSERT_EQ(TypeToken<std::vector<int>>::id(), data.typeId());
+    ASSERT_EQ(TypeToken<std::vector<int>>::name(), data.type());
+    ASSERT_EQ(&data, Data<std::vector<int>>::cast(&data));
+    ASSERT_EQ(nullptr, Data<std::vector<float>>::cast(&data));
+
+    InputSlot<std::vector<int>> slot;
+    InputSlot<std::vector<float>> otherSlot;
+    ASSERT_TRUE(slot.matchType(data));
+    ASSERT_FALSE(otherSlot.matchType(data));
+    ASSERT_TRUE(slot.connectTo(data));
+    ASSERT_EQ(&data, slot.connectedData());
+}
@@ -20,6 +20,7 @@ public:
         const std::vector<std::string> & inputNames,
         const std::vector<std::string> & outputNames)
     :   AbstractStage(name)
+    ,   processCount(0)
     {
         for (const auto & inputName : inputNames)
         {
@@ -34,10 +35,27 @@ public:
     
     virtual void process() override
     {
+        ++processCount;
+
+        int value = 1;
+
+        for (const auto & input : inputs)
+        {
+            value += input.second.data();
+        }
+
+        for (auto & output : outputs)
+        {
+            output.second.data() = value;
+        }
+
+        invalidateOutputs();
     }
 
 
 public:
     std::map<std::string, InputSlot<int>> inputs;
     std::map<std::string, Data<int>> outputs;
+
+    int processCount;
 };
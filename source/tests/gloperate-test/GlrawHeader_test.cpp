@@ -0,0 +1,266 @@
+
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <glbinding/gl/gl.h>
+
+#include <gloperate/resources/GlrawHeader.h>
+#include <gloperate/resources/RawFile.h>
+
+
+using namespace gloperate;
+
+
+namespace
+{
+    // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 16 bytes per block
+    const int s_compressedFormat = 0x83F3;
+}
+
+
+class GlrawHeader_test : public testing::Test
+{
+public:
+    GlrawHeader_test()
+    :   filePath("GlrawHeader_test.glraw")
+    {
+    }
+
+    virtual ~GlrawHeader_test()
+    {
+        std::remove(filePath.c_str());
+    }
+
+    void addInteger(const std::string & key, int value)
+    {
+        const std::int32_t integer = value;
+
+        properties.push_back(1);
+        properties.insert(properties.end(), key.c_str(), key.c_str() + key.size() + 1);
+        append(properties, &integer, sizeof(integer));
+    }
+
+    void addDouble(const std::string & key, double value)
+    {
+        properties.push_back(2);
+        properties.insert(properties.end(), key.c_str(), key.c_str() + key.size() + 1);
+        append(properties, &value, sizeof(value));
+    }
+
+    void addString(const std::string & key, const std::string & value)
+    {
+        properties.push_back(3);
+        properties.insert(properties.end(), key.c_str(), key.c_str() + key.size() + 1);
+        properties.insert(properties.end(), value.c_str(), value.c_str() + value.size() + 1);
+    }
+
+    // Write the header and dataSize bytes of texture data, the header can be cut off after headerSize bytes
+    void writeFile(size_t dataSize, std::uint16_t magicNumber = 0xC4F3, size_t headerSize = std::string::npos)
+    {
+        std::vector<char> content;
+
+        const std::uint64_t offset = sizeof(magicNumber) + sizeof(offset) + properties.size();
+        append(content, &magicNumber, sizeof(magicNumber));
+        append(content, &offset, sizeof(offset));
+        content.insert(content.end(), properties.begin(), properties.end());
+
+        if (headerSize < content.size())
+            content.resize(headerSize);
+        else
+            content.resize(content.size() + dataSize, 'x');
+
+        std::ofstream ofs(filePath, std::ios::out | std::ios::binary);
+        ofs.write(content.data(), content.size());
+    }
+
+    size_t dataOffset() const
+    {
+        return sizeof(std::uint16_t) + sizeof(std::uint64_t) + properties.size();
+    }
+
+    static void append(std::vector<char> & data, const void * value, size_t size)
+    {
+        const char * bytes = static_cast<const char *>(value);
+        data.insert(data.end(), bytes, bytes + size);
+    }
+
+public:
+    std::string filePath;
+    std::vector<char> properties;
+};
+
+
+TEST_F(GlrawHeader_test, UncompressedHeaderIsRead)
+{
+    addInteger("width", 5);
+    addString("source", "test.png");
+    addInteger("height", 3);
+    addDouble("scale", 0.5);
+    addInteger("format", static_cast<int>(gl::GL_RGBA));
+    addInteger("type", static_cast<int>(gl::GL_UNSIGNED_BYTE));
+    writeFile(5 * 3 * 4);
+
+    RawFile file(filePath);
+    GlrawHeader header;
+
+    ASSERT_TRUE(GlrawHeader::hasMagicNumber(file.data(), file.size()));
+    ASSERT_TRUE(header.read(file));
+
+    // Other property types are skipped
+    ASSERT_EQ(4u, header.properties().size());
+    ASSERT_EQ(5, header.property("width"));
+    ASSERT_EQ(-1, header.property("scale", -1));
+    ASSERT_FALSE(header.isCompressed());
+    ASSERT_EQ(dataOffset(), header.dataOffset());
+
+    ASSERT_EQ(1u, header.levels().size());
+    const GlrawHeader::Level & level = header.levels().front();
+    ASSERT_EQ(5, level.width);
+    ASSERT_EQ(3, level.height);
+    ASSERT_EQ(1, level.rowHeight);
+    ASSERT_EQ(3u, level.rows);
+    ASSERT_EQ(20u, level.rowSize);
+
+    ASSERT_EQ(60u, header.dataSize());
+    ASSERT_TRUE(header.isComplete(file.size()));
+}
+
+TEST_F(GlrawHeader_test, TruncatedHeaderIsRejected)
+{
+    addInteger("width", 4);
+    addInteger("height", 4);
+
+    GlrawHeader header;
+
+    // Cut off within the prefix
+    writeFile(0, 0xC4F3, 6);
+    ASSERT_FALSE(header.read(RawFile(filePath)));
+
+    // Cut off within a property, the data offset exceeds the file
+    writeFile(0, 0xC4F3, dataOffset() - 2);
+    ASSERT_FALSE(header.read(RawFile(filePath)));
+
+    // Properties must end at the data offset
+    properties.resize(properties.size() - 2);
+    writeFile(64);
+    ASSERT_FALSE(header.read(RawFile(filePath)));
+    ASSERT_TRUE(header.properties().empty());
+    ASSERT_TRUE(header.levels().empty());
+}
+
+TEST_F(GlrawHeader_test, BadMagicNumberIsRejected)
+{
+    addInteger("width", 4);
+    addInteger("height", 4);
+    addInteger("format", static_cast<int>(gl::GL_RED));
+    addInteger("type", static_cast<int>(gl::GL_UNSIGNED_BYTE));
+    writeFile(16, 0xF3C4);
+
+    RawFile file(filePath);
+    GlrawHeader header;
+
+    ASSERT_FALSE(GlrawHeader::hasMagicNumber(file.data(), file.size()));
+    ASSERT_FALSE(GlrawHeader::hasMagicNumber(file.data(), 1));
+    ASSERT_FALSE(header.read(file));
+}
+
+TEST_F(GlrawHeader_test, CompressedLevelsUseBlocks)
+{
+    // 3x2 blocks of 16 bytes in the first level
+    addInteger("width", 10);
+    addInteger("height", 6);
+    addInteger("compressedFormat", s_compressedFormat);
+    addInteger("size", 3 * 2 * 16);
+    addInteger("levels", 3);
+    writeFile(96 + 32 + 16);
+
+    RawFile file(filePath);
+    GlrawHeader header;
+
+    ASSERT_TRUE(header.read(file));
+    ASSERT_TRUE(header.isCompressed());
+    ASSERT_EQ(3u, header.levels().size());
+
+    const auto & levels = header.levels();
+    ASSERT_EQ(4, levels[0].rowHeight);
+    ASSERT_EQ(2u, levels[0].rows);
+    ASSERT_EQ(48u, levels[0].rowSize);
+
+    // Levels smaller than a block still take a whole block
+    ASSERT_EQ(5, levels[1].width);
+    ASSERT_EQ(3, levels[1].height);
+    ASSERT_EQ(1u, levels[1].rows);
+    ASSERT_EQ(32u, levels[1].rowSize);
+    ASSERT_EQ(2, levels[2].width);
+    ASSERT_EQ(1, levels[2].height);
+    ASSERT_EQ(1u, levels[2].rows);
+    ASSERT_EQ(16u, levels[2].rowSize);
+
+    ASSERT_EQ(144u, header.dataSize());
+    ASSERT_TRUE(header.isComplete(file.size()));
+}
+
+TEST_F(GlrawHeader_test, InvalidCompressedSizeHasNoLevels)
+{
+    addInteger("width", 8);
+    addInteger("height", 8);
+    addInteger("compressedFormat", s_compressedFormat);
+    addInteger("size", 50);
+    writeFile(50);
+
+    RawFile file(filePath);
+    GlrawHeader header;
+
+    ASSERT_TRUE(header.read(file));
+    ASSERT_TRUE(header.levels().empty());
+    ASSERT_FALSE(header.isComplete(file.size()));
+}
+
+TEST_F(GlrawHeader_test, MultipleLevelsMustFitIntoFile)
+{
+    addInteger("width", 8);
+    addInteger("height", 4);
+    addInteger("format", static_cast<int>(gl::GL_RGB));
+    addInteger("type", static_cast<int>(gl::GL_UNSIGNED_BYTE));
+    addInteger("levels", 4);
+
+    // 8x4, 4x2, 2x1 and 1x1 pixels of 3 bytes
+    const size_t dataSize = (32 + 8 + 2 + 1) * 3;
+
+    GlrawHeader header;
+
+    writeFile(dataSize);
+    RawFile complete(filePath);
+    ASSERT_TRUE(header.read(complete));
+    ASSERT_EQ(4u, header.levels().size());
+    ASSERT_EQ(1, header.levels().back().width);
+    ASSERT_EQ(1, header.levels().back().height);
+    ASSERT_EQ(dataSize, header.dataSize());
+    ASSERT_TRUE(header.isComplete(complete.size()));
+
+    writeFile(dataSize - 1);
+    RawFile truncated(filePath);
+    ASSERT_TRUE(header.read(truncated));
+    ASSERT_FALSE(header.isComplete(truncated.size()));
+}
+
+TEST_F(GlrawHeader_test, LevelsBeyondSmallestAreRejected)
+{
+    addInteger("width", 8);
+    addInteger("height", 4);
+    addInteger("format", static_cast<int>(gl::GL_RGBA));
+    addInteger("type", static_cast<int>(gl::GL_FLOAT));
+    addInteger("levels", 5);
+    writeFile(1024);
+
+    GlrawHeader header;
+
+    ASSERT_TRUE(header.read(RawFile(filePath)));
+    ASSERT_TRUE(header.levels().empty());
+}
@@ -0,0 +1,74 @@
+#include <gmock/gmock.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gloperate/resources/RawFile.h>
+
+
+using namespace gloperate;
+
+
+class RawFile_test : public testing::Test
+{
+public:
+    RawFile_test()
+    :   filePath("RawFile_test.raw")
+    {
+        for (size_t i = 0; i < 10000; ++i)
+        {
+            content.push_back(static_cast<char>(i * 7));
+        }
+
+        std::ofstream ofs(filePath, std::ios::out | std::ios::binary);
+        ofs.write(content.data(), content.size());
+    }
+
+    virtual ~RawFile_test()
+    {
+        std::remove(filePath.c_str());
+    }
+
+public:
+    std::string filePath;
+    std::vector<char> content;
+};
+
+
+TEST_F(RawFile_test, ModesProvideSameContent)
+{
+    RawFile mapped(filePath);
+    RawFile read(filePath, RawFile::Mode::Read);
+    RawFile streamed(filePath, RawFile::Mode::Stream);
+
+    ASSERT_TRUE(mapped.isValid());
+    ASSERT_TRUE(read.isValid());
+    ASSERT_TRUE(streamed.isValid());
+
+    ASSERT_EQ(content, std::vector<char>(mapped.data(), mapped.data() + mapped.size()));
+    ASSERT_EQ(content, std::vector<char>(read.data(), read.data() + read.size()));
+    ASSERT_EQ(nullptr, streamed.data());
+    ASSERT_EQ(content.size(), streamed.size());
+
+    // Ranges are clamped to the end of the file
+    std::vector<char> range(100);
+
+    for (const RawFile * file : { &mapped, &read, &streamed })
+    {
+        ASSERT_EQ(100u, file->read(5000, range.size(), range.data()));
+        ASSERT_EQ(std::vector<char>(content.begin() + 5000, content.begin() + 5100), range);
+
+        ASSERT_EQ(40u, file->read(content.size() - 40, range.size(), range.data()));
+        ASSERT_EQ(0u, file->read(content.size(), range.size(), range.data()));
+    }
+
+    // Moving transfers the mapping
+    RawFile moved(std::move(mapped));
+    ASSERT_TRUE(moved.isValid());
+    ASSERT_FALSE(mapped.isValid());
+    ASSERT_EQ(content.back(), moved.data()[moved.size() - 1]);
+
+    ASSERT_FALSE(RawFile("missing.raw").isValid());
+}
@@ -0,0 +1,395 @@
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <globjects/base/Referenced.h>
+
+#include <gloperate/resources/Loader.h>
+#include <gloperate/resources/ResourceManager.h>
+
+
+using namespace gloperate;
+
+
+class ResourceManager_test : public testing::Test
+{
+public:
+    ResourceManager_test()
+    {
+    }
+};
+
+
+namespace
+{
+    class PreparedNumber : public AbstractLoader::Prepared
+    {
+    public:
+        int value;
+        std::thread::id thread;
+    };
+
+    // Reads numbers from the file name, e.g., "42.num", throws for names that are no numbers and for zero
+    class NumberLoader : public Loader<int>
+    {
+    public:
+        NumberLoader(bool requiresContext)
+        :   m_requiresContext(requiresContext)
+        {
+        }
+
+        virtual bool canLoad(const std::string & ext) const override
+        {
+            return ext == "num";
+        }
+
+        virtual std::vector<std::string> loadingTypes() const override
+        {
+            return { "Number (*.num)" };
+        }
+
+        virtual std::string allLoadingTypes() const override
+        {
+            return "*.num";
+        }
+
+        virtual bool requiresContext() const override
+        {
+            return m_requiresContext;
+        }
+
+        virtual int * load(const std::string & filename, const reflectionzeug::Variant & options, std::function<void(int, int)> progress) const override
+        {
+            return finish(filename, options, prepare(filename, options, progress), progress);
+        }
+
+        virtual std::unique_ptr<Prepared> prepare(const std::string & filename, const reflectionzeug::Variant & /*options*/, std::function<void(int, int)> progress) const override
+        {
+            auto number = new PreparedNumber;
+            std::unique_ptr<Prepared> prepared(number);
+
+            number->value = std::stoi(filename);
+            number->thread = std::this_thread::get_id();
+
+            if (progress)
+                progress(1, 2);
+
+            return prepared;
+        }
+
+        virtual int * finish(const std::string & /*filename*/, const reflectionzeug::Variant & /*options*/, std::unique_ptr<Prepared> prepared, std::function<void(int, int)> /*progress*/) const override
+        {
+            auto number = static_cast<PreparedNumber *>(prepared.get());
+
+            if (number->value == 0)
+                throw std::runtime_error("zero cannot be finished");
+
+            // Values prepared on the calling thread are marked as negative
+            return new int(number->thread == std::this_thread::get_id() ? -number->value : number->value);
+        }
+
+    protected:
+        bool m_requiresContext;
+    };
+
+    class Number : public globjects::Referenced
+    {
+    public:
+        Number(int value)
+        :   value(value)
+        {
+        }
+
+    public:
+        int value;
+    };
+
+    class SlowNumberLoader : public Loader<Number>
+    {
+    public:
+        SlowNumberLoader()
+        :   loads(0)
+        {
+        }
+
+        virtual bool canLoad(const std::string & ext) const override
+        {
+            return ext == "num";
+        }
+
+        virtual std::vector<std::string> loadingTypes() const override
+        {
+            return { "Number (*.num)" };
+        }
+
+        virtual std::string allLoadingTypes() const override
+        {
+            return "*.num";
+        }
+
+        virtual Number * load(const std::string & filename, const reflectionzeug::Variant & /*options*/, std::function<void(int, int)> /*progress*/) const override
+        {
+            ++loads;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+            return new Number(std::stoi(filename));
+        }
+
+    public:
+        mutable std::atomic<int> loads;
+    };
+
+    // Recognizes files starting with its tag, e.g., "A:text"
+    class TaggedLoader : public Loader<std::string>
+    {
+    public:
+        TaggedLoader(char tag)
+        :   m_tag(tag)
+        {
+        }
+
+        virtual bool canLoad(const std::string & ext) const override
+        {
+            return ext == "txt";
+        }
+
+        virtual std::vector<std::string> loadingTypes() const override
+        {
+            return { "Tagged text (*.txt)" };
+        }
+
+        virtual std::string allLoadingTypes() const override
+        {
+            return "*.txt";
+        }
+
+        virtual bool canLoadContent(const char * header, size_t size) const override
+        {
+            return size >= 2 && header[0] == m_tag && header[1] == ':';
+        }
+
+        virtual std::string * load(const std::string & /*filename*/, const reflectionzeug::Variant & /*options*/, std::function<void(int, int)> /*progress*/) const override
+        {
+            return new std::string(1, m_tag);
+        }
+
+    protected:
+        char m_tag;
+    };
+
+    void writeFile(const std::string & filename, const std::string & content)
+    {
+        std::ofstream stream(filename, std::ios::out | std::ios::binary);
+        stream << content;
+    }
+}
+
+
+TEST_F(ResourceManager_test, AsyncLoadingUploadsOnCallingThread)
+{
+    ResourceManager resourceManager(2);
+    resourceManager.addLoader(new NumberLoader(true));
+
+    auto request = resourceManager.loadAsync<int>("42.num");
+    ASSERT_NE(nullptr, request);
+    ASSERT_EQ(nullptr, resourceManager.loadAsync<int>("42.txt"));
+
+    // The value is read on a loading thread and finished here
+    while (request->status() != AbstractLoadRequest::Status::Uploading)
+    {
+        std::this_thread::yield();
+    }
+
+    ASSERT_FLOAT_EQ(0.5f, request->progress());
+    ASSERT_TRUE(resourceManager.hasPendingRequests());
+    ASSERT_EQ(1u, resourceManager.processUploads());
+    ASSERT_TRUE(request->isDone());
+    ASSERT_FALSE(resourceManager.hasPendingRequests());
+
+    std::unique_ptr<int> value(request->get());
+    ASSERT_EQ(42, *value);
+
+    auto canceled = resourceManager.loadAsync<int>("7.num");
+    canceled->cancel();
+    resourceManager.processUploads();
+
+    ASSERT_EQ(nullptr, canceled->get());
+    ASSERT_EQ(AbstractLoadRequest::Status::Canceled, canceled->status());
+}
+
+TEST_F(ResourceManager_test, AsyncLoadingWithoutContextFinishesOnLoadingThread)
+{
+    ResourceManager resourceManager(2);
+    resourceManager.addLoader(new NumberLoader(false));
+
+    auto request = resourceManager.loadAsync<int>("13.num");
+
+    std::unique_ptr<int> value(request->get());
+    ASSERT_EQ(-13, *value);
+    ASSERT_EQ(AbstractLoadRequest::Status::Finished, request->status());
+    ASSERT_EQ(0u, resourceManager.processUploads());
+}
+
+TEST_F(ResourceManager_test, AsyncLoadingPassesLoaderExceptions)
+{
+    for (bool requiresContext : { false, true })
+    {
+        ResourceManager resourceManager(2);
+        resourceManager.addLoader(new NumberLoader(requiresContext));
+
+        // Thrown on the loading thread
+        auto invalid = resourceManager.loadAsync<int>("invalid.num");
+        ASSERT_THROW(invalid->get(), std::invalid_argument);
+        ASSERT_EQ(AbstractLoadRequest::Status::Finished, invalid->status());
+
+        if (requiresContext)
+        {
+            // Thrown on the context thread
+            auto zero = resourceManager.loadAsync<int>("0.num");
+
+            while (zero->status() != AbstractLoadRequest::Status::Uploading)
+            {
+                std::this_thread::yield();
+            }
+
+            ASSERT_EQ(1u, resourceManager.processUploads());
+            ASSERT_THROW(zero->get(), std::runtime_error);
+            ASSERT_EQ(AbstractLoadRequest::Status::Finished, zero->status());
+        }
+
+        ASSERT_FALSE(resourceManager.hasPendingRequests());
+    }
+}
+
+TEST_F(ResourceManager_test, CachedResourcesAreSharedAndEvicted)
+{
+    auto loader = new SlowNumberLoader;
+
+    ResourceManager resourceManager;
+    resourceManager.addLoader(loader);
+
+    // Each number counts its object size
+    resourceManager.cache().setBudget(sizeof(Number));
+
+    auto one = resourceManager.get<Number>("1.num");
+    ASSERT_EQ(one, resourceManager.get<Number>("1.num"));
+    ASSERT_NE(one, resourceManager.get<Number>("1.num", reflectionzeug::Variant(2)));
+    ASSERT_EQ(2, loader->loads);
+
+    // Resources in use are kept beyond the budget
+    ASSERT_EQ(2u, resourceManager.cache().statistics().entries);
+
+    one = nullptr;
+    auto two = resourceManager.get<Number>("2.num");
+    ASSERT_EQ(2, two->value);
+
+    const auto statistics = resourceManager.cache().statistics();
+    ASSERT_EQ(1u, statistics.hits);
+    ASSERT_EQ(3u, statistics.misses);
+    ASSERT_EQ(2u, statistics.evictions);
+    ASSERT_EQ(1u, statistics.entries);
+    ASSERT_EQ(sizeof(Number), statistics.bytes);
+
+    // Dropped references are released without another miss
+    auto three = resourceManager.get<Number>("3.num");
+    ASSERT_EQ(2u, resourceManager.cache().statistics().entries);
+
+    two = nullptr;
+    three = nullptr;
+    resourceManager.processUploads();
+
+    ASSERT_EQ(3u, resourceManager.cache().statistics().evictions);
+    ASSERT_EQ(1u, resourceManager.cache().statistics().entries);
+    ASSERT_EQ(sizeof(Number), resourceManager.cache().statistics().bytes);
+}
+
+TEST_F(ResourceManager_test, ConcurrentRequestsLoadOnce)
+{
+    auto loader = new SlowNumberLoader;
+
+    ResourceManager resourceManager;
+    resourceManager.addLoader(loader);
+
+    std::vector<globjects::ref_ptr<Number>> numbers(4);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < numbers.size(); ++i)
+    {
+        threads.emplace_back([&resourceManager, &numbers, i]()
+        {
+            numbers[i] = resourceManager.get<Number>("3.num");
+        });
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(1, loader->loads);
+
+    for (const auto & number : numbers)
+    {
+        ASSERT_EQ(numbers.front(), number);
+    }
+}
+
+TEST_F(ResourceManager_test, ThrowingLoadsAreNotCached)
+{
+    ResourceCache cache;
+
+    ASSERT_THROW(cache.get("key", []() -> std::pair<globjects::Referenced *, size_t>
+    {
+        throw std::runtime_error("load failed");
+    }), std::runtime_error);
+
+    ASSERT_FALSE(cache.contains("key"));
+
+    // A later request loads again instead of waiting for the failed load
+    auto number = cache.get("key", []()
+    {
+        return std::pair<globjects::Referenced *, size_t>(new Number(7), sizeof(Number));
+    });
+
+    ASSERT_EQ(7, static_cast<Number *>(number.get())->value);
+}
+
+TEST_F(ResourceManager_test, LoadersAreFoundByExtensionAndContent)
+{
+    writeFile("tagged.txt", "B:text");
+    writeFile("untagged.txt", "text");
+    writeFile("tagged", "B:text");
+
+    ResourceManager resourceManager;
+    resourceManager.addLoader(new NumberLoader(false));
+    resourceManager.addLoader(new TaggedLoader('A'));
+    resourceManager.addLoader(new TaggedLoader('B'));
+
+    std::unique_ptr<int> number(resourceManager.load<int>("42.num"));
+    ASSERT_EQ(-42, *number);
+
+    // Ambiguous extensions are resolved by content, falling back to the first loader
+    std::unique_ptr<std::string> tagged(resourceManager.load<std::string>("tagged.txt"));
+    std::unique_ptr<std::string> untagged(resourceManager.load<std::string>("untagged.txt"));
+    std::unique_ptr<std::string> withoutExtension(resourceManager.load<std::string>("tagged"));
+
+    ASSERT_EQ("B", *tagged);
+    ASSERT_EQ("A", *untagged);
+    ASSERT_EQ("B", *withoutExtension);
+
+    // Loaders of other types are not used
+    ASSERT_EQ(nullptr, resourceManager.load<int>("tagged.txt"));
+    ASSERT_EQ(nullptr, resourceManager.load<std::string>("42.num"));
+
+    std::remove("tagged.txt");
+    std::remove("untagged.txt");
+    std::remove("tagged");
+}
@@ -0,0 +1,111 @@
+#include "RunScript.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+
+bool RunScript::fromJson(const QJsonDocument & document, RunScript & script, QString * error)
+{
+    const auto fail = [error] (const QString & message)
+    {
+        if (error)
+            *error = message;
+
+        return false;
+    };
+
+    if (!document.isObject())
+        return fail("script must be an object");
+
+    const auto object = document.object();
+
+    if (object.contains("frames"))
+        script.setFrames(object.value("frames").toInt(script.frames()));
+
+    script.setSize(
+        object.value("width").toInt(script.width()),
+        object.value("height").toInt(script.height()));
+
+    const auto changesValue = object.value("changes");
+
+    if (!changesValue.isUndefined() && !changesValue.isArray())
+        return fail("\"changes\" must be an array");
+
+    for (const auto & changeValue : changesValue.toArray())
+    {
+        const auto changeObject = changeValue.toObject();
+
+        if (!changeObject.value("frame").isDouble() || !changeObject.value("property").isString())
+            return fail("each change requires \"frame\" and \"property\"");
+
+        const auto value = changeObject.value("value");
+
+        Change change;
+        change.frame = changeObject.value("frame").toInt();
+        change.property = changeObject.value("property").toString();
+        change.value = value.isString() ? value.toString() : value.toVariant().toString();
+
+        script.m_changes.push_back(change);
+    }
+
+    std::stable_sort(script.m_changes.begin(), script.m_changes.end(), [] (const Change & lhs, const Change & rhs)
+    {
+        return lhs.frame < rhs.frame;
+    });
+
+    return true;
+}
+
+RunScript::RunScript()
+: m_frames(100)
+, m_width(1280)
+, m_height(720)
+{
+}
+
+int RunScript::frames() const
+{
+    return m_frames;
+}
+
+void RunScript::setFrames(int frames)
+{
+    m_frames = std::max(frames, 0);
+}
+
+int RunScript::width() const
+{
+    return m_width;
+}
+
+int RunScript::height() const
+{
+    return m_height;
+}
+
+void RunScript::setSize(int width, int height)
+{
+    m_width = std::max(width, 1);
+    m_height = std::max(height, 1);
+}
+
+const std::vector<RunScript::Change> & RunScript::changes() const
+{
+    return m_changes;
+}
+
+std::vector<RunScript::Change> RunScript::changesAt(int frame) const
+{
+    std::vector<Change> changes;
+
+    std::copy_if(m_changes.begin(), m_changes.end(), std::back_inserter(changes), [frame] (const Change & change)
+    {
+        return change.frame == frame;
+    });
+
+    return changes;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+
+#include <QString>
+
+
+class QJsonDocument;
+
+
+/**
+*  @brief
+*    Frames and scripted property changes of a headless run
+*
+*    A script is a JSON document of the form
+*
+*    \code{.json}
+*
+*        {
+*            "frames": 300,
+*            "width": 1280,
+*            "height": 720,
+*            "changes": [
+*                { "frame": 100, "property": "Pipeline/width", "value": "512" }
+*            ]
+*        }
+*
+*    \endcode
+*
+*    Values are given as strings and assigned using the string conversion
+*    of the painter's properties. All keys are optional.
+*/
+class RunScript
+{
+public:
+    struct Change
+    {
+        int frame;
+        QString property;
+        QString value;
+    };
+
+public:
+    static bool fromJson(const QJsonDocument & document, RunScript & script, QString * error);
+
+public:
+    RunScript();
+
+    int frames() const;
+    void setFrames(int frames);
+
+    int width() const;
+    int height() const;
+    void setSize(int width, int height);
+
+    const std::vector<Change> & changes() const;
+    std::vector<Change> changesAt(int frame) const;
+
+private:
+    int m_frames;
+    int m_width;
+    int m_height;
+    std::vector<Change> m_changes;
+};
@@ -0,0 +1,360 @@
+#include "Runner.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <QDebug>
+#include <QJsonArray>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QSurfaceFormat>
+#include <QTextStream>
+
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/functions.h>
+
+#include <globjects/globjects.h>
+#include <globjects/Framebuffer.h>
+#include <globjects/Renderbuffer.h>
+#include <globjects/Texture.h>
+
+#include <gloperate/ext-includes-begin.h>
+#include <reflectionzeug/property/AbstractValueProperty.h>
+#include <gloperate/ext-includes-end.h>
+
+#include <gloperate/base/ChronoTimer.h>
+#include <gloperate/base/make_unique.hpp>
+#include <gloperate/painter/Painter.h>
+#include <gloperate/painter/AbstractTargetFramebufferCapability.h>
+#include <gloperate/painter/AbstractViewportCapability.h>
+#include <gloperate/painter/AbstractVirtualTimeCapability.h>
+#include <gloperate/pipeline/AbstractPipeline.h>
+#include <gloperate/pipeline/PipelinePainter.h>
+#include <gloperate/pipeline/StageProfiler.h>
+#include <gloperate/plugin/PainterPlugin.h>
+#include <gloperate/plugin/PluginManager.h>
+#include <gloperate/resources/ResourceManager.h>
+#include <gloperate/resources/GlrawTextureLoader.h>
+
+#include <gloperate-qt/viewer/QtTextureLoader.h>
+#include <gloperate-qt/viewer/QtTextureStorer.h>
+
+#include "RunScript.h"
+
+
+namespace
+{
+
+const auto frameDelta = 1.0f / 60.0f;
+
+double milliseconds(gloperate::ChronoTimer::Duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(duration).count();
+}
+
+QJsonObject summarize(std::vector<double> values)
+{
+    QJsonObject summary;
+
+    if (values.empty())
+        return summary;
+
+    std::sort(values.begin(), values.end());
+
+    double sum = 0.0;
+
+    for (const auto value : values)
+        sum += value;
+
+    const auto percentile = [&values] (double fraction)
+    {
+        return values[std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()))];
+    };
+
+    summary["mean"] = sum / values.size();
+    summary["min"] = values.front();
+    summary["max"] = values.back();
+    summary["median"] = percentile(0.5);
+    summary["p95"] = percentile(0.95);
+
+    return summary;
+}
+
+}
+
+
+Runner::Runner()
+: m_resourceManager(gloperate::make_unique<gloperate::ResourceManager>())
+, m_pluginManager(gloperate::make_unique<gloperate::PluginManager>())
+, m_compiled(false)
+{
+    m_resourceManager->addLoader(new gloperate_qt::QtTextureLoader());
+    m_resourceManager->addLoader(new gloperate::GlrawTextureLoader());
+    m_resourceManager->addStorer(new gloperate_qt::QtTextureStorer());
+}
+
+Runner::~Runner()
+{
+    // OpenGL objects have to be released while the context is current
+    if (m_context && m_context->makeCurrent(m_surface.get()))
+    {
+        m_painter.reset();
+        m_fbo = nullptr;
+        m_color = nullptr;
+        m_depth = nullptr;
+
+        m_context->doneCurrent();
+    }
+}
+
+bool Runner::createContext()
+{
+    QSurfaceFormat format;
+    format.setVersion(3, 2);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+    format.setDepthBufferSize(24);
+
+    m_context = gloperate::make_unique<QOpenGLContext>();
+    m_context->setFormat(format);
+
+    if (!m_context->create())
+        return false;
+
+    m_surface = gloperate::make_unique<QOffscreenSurface>();
+    m_surface->setFormat(m_context->format());
+    m_surface->create();
+
+    if (!m_surface->isValid() || !m_context->makeCurrent(m_surface.get()))
+        return false;
+
+    globjects::init();
+
+    m_fbo = new globjects::Framebuffer();
+    m_color = globjects::Texture::createDefault(gl::GL_TEXTURE_2D);
+    m_depth = new globjects::Renderbuffer();
+
+    m_fbo->attachTexture(gl::GL_COLOR_ATTACHMENT0, m_color);
+    m_fbo->attachRenderBuffer(gl::GL_DEPTH_ATTACHMENT, m_depth);
+
+    return true;
+}
+
+void Runner::addPluginPath(const QString & path)
+{
+    m_pluginManager->addSearchPath(path.toStdString());
+}
+
+void Runner::scanPlugins()
+{
+    // Scan all plugins with name component 'painters'
+#ifdef NDEBUG
+    m_pluginManager->scan("painters");
+#else
+    m_pluginManager->scan("paintersd");
+#endif
+}
+
+QStringList Runner::painterNames() const
+{
+    QStringList names;
+
+    for (const auto plugin : m_pluginManager->plugins())
+    {
+        if (dynamic_cast<gloperate::AbstractPainterPlugin *>(plugin))
+            names << QString::fromStdString(plugin->name());
+    }
+
+    return names;
+}
+
+void Runner::setCompiled(bool compiled)
+{
+    m_compiled = compiled;
+}
+
+bool Runner::loadPainter(const QString & name)
+{
+    const auto plugin = m_pluginManager->plugin(name.toStdString());
+    const auto painterPlugin = plugin ? dynamic_cast<gloperate::AbstractPainterPlugin *>(plugin) : nullptr;
+
+    if (!painterPlugin)
+        return false;
+
+    m_painter.reset(painterPlugin->createPainter(*m_resourceManager));
+    m_painterName = name;
+
+    if (!m_painter)
+        return false;
+
+    // Profiling has to be enabled before the first frame
+    if (const auto pipeline = painterPipeline())
+        pipeline->setProfiling(true);
+
+    if (const auto fboCapability = m_painter->getCapability<gloperate::AbstractTargetFramebufferCapability>())
+        fboCapability->setFramebuffer(m_fbo);
+
+    m_painter->initialize();
+
+    if (m_compiled && painterPipeline() && !painterPipeline()->compile())
+        qDebug() << "WARNING: pipeline of" << name << "could not be compiled";
+
+    return true;
+}
+
+QJsonObject Runner::run(const RunScript & script, QTextStream * stageTimes)
+{
+    QJsonObject report;
+
+    if (!m_painter)
+        return report;
+
+    resizeTarget(script.width(), script.height());
+
+    const auto virtualTime = m_painter->getCapability<gloperate::AbstractVirtualTimeCapability>();
+
+    std::vector<double> frameTimes;
+    frameTimes.reserve(script.frames());
+
+    QJsonArray frameTimesArray;
+    QJsonArray failedChanges;
+
+    gloperate::ChronoTimer timer(false);
+
+    // Start of the last pipeline execution written to the stage times
+    long long lastExecution = -1;
+
+    if (stageTimes)
+        *stageTimes << "frame,stage,start,duration" << endl;
+
+    for (int frame = 0; frame < script.frames(); ++frame)
+    {
+        for (const auto & change : script.changesAt(frame))
+        {
+            if (!applyChange(change.property, change.value))
+            {
+                qDebug() << "WARNING: cannot assign" << change.value << "to property" << change.property;
+
+                QJsonObject failedChange;
+                failedChange["frame"] = change.frame;
+                failedChange["property"] = change.property;
+
+                failedChanges.append(failedChange);
+            }
+        }
+
+        if (virtualTime && virtualTime->enabled())
+            virtualTime->update(frameDelta);
+
+        timer.reset();
+        timer.start();
+
+        m_painter->paint();
+
+        // Include the GPU work of the frame
+        gl::glFinish();
+
+        timer.pause();
+
+        const auto frameTime = milliseconds(timer.elapsed());
+
+        frameTimes.push_back(frameTime);
+        frameTimesArray.append(frameTime);
+
+        if (stageTimes)
+            writeStageTimes(frame, *stageTimes, lastExecution);
+    }
+
+    report["painter"] = m_painterName;
+    report["frames"] = script.frames();
+    report["width"] = script.width();
+    report["height"] = script.height();
+    report["compiled"] = painterPipeline() && painterPipeline()->isCompiled();
+    report["frameTimes"] = frameTimesArray;
+    report["summary"] = summarize(frameTimes);
+    report["stages"] = stageStatistics();
+
+    if (!failedChanges.isEmpty())
+        report["failedChanges"] = failedChanges;
+
+    return report;
+}
+
+void Runner::resizeTarget(int width, int height)
+{
+    m_color->image2D(0, gl::GL_RGBA, width, height, 0, gl::GL_RGBA, gl::GL_UNSIGNED_BYTE, nullptr);
+    m_depth->storage(gl::GL_DEPTH_COMPONENT32, width, height);
+
+    if (const auto viewportCapability = m_painter->getCapability<gloperate::AbstractViewportCapability>())
+        viewportCapability->setViewport(0, 0, width, height);
+}
+
+bool Runner::applyChange(const QString & property, const QString & value)
+{
+    const auto abstractProperty = m_painter->property(property.toStdString());
+    const auto valueProperty = abstractProperty ? abstractProperty->asValue() : nullptr;
+
+    if (!valueProperty)
+        return false;
+
+    return valueProperty->fromString(value.toStdString());
+}
+
+gloperate::AbstractPipeline * Runner::painterPipeline() const
+{
+    const auto pipelinePainter = dynamic_cast<gloperate::PipelinePainter *>(m_painter.get());
+
+    return pipelinePainter ? &pipelinePainter->pipeline() : nullptr;
+}
+
+void Runner::writeStageTimes(int frame, QTextStream & stream, long long & lastExecution) const
+{
+    const auto pipeline = painterPipeline();
+    const auto profiler = pipeline ? pipeline->profiler() : nullptr;
+
+    if (!profiler)
+        return;
+
+    const auto statistics = profiler->statistics();
+
+    // A frame can execute the pipeline several times, or not at all
+    for (const auto & execution : profiler->frames())
+    {
+        if (execution.start.count() <= lastExecution)
+            continue;
+
+        lastExecution = execution.start.count();
+
+        for (const auto & event : execution.events)
+        {
+            stream << frame << ",\"" << QString::fromStdString(statistics[event.stageIndex].stageName) << "\","
+                   << milliseconds(event.start - execution.start) << "," << milliseconds(event.duration) << "\n";
+        }
+    }
+}
+
+QJsonArray Runner::stageStatistics() const
+{
+    QJsonArray stages;
+
+    const auto pipeline = painterPipeline();
+    const auto profiler = pipeline ? pipeline->profiler() : nullptr;
+
+    if (!profiler)
+        return stages;
+
+    for (const auto & statistics : profiler->statistics())
+    {
+        QJsonObject stage;
+        stage["name"] = QString::fromStdString(statistics.stageName);
+        stage["invocations"] = static_cast<int>(statistics.invocations);
+        stage["skips"] = static_cast<int>(statistics.skips);
+        stage["totalTime"] = milliseconds(statistics.totalTime);
+        stage["meanTime"] = statistics.invocations > 0 ? milliseconds(statistics.totalTime) / statistics.invocations : 0.0;
+        stage["minTime"] = statistics.invocations > 0 ? milliseconds(statistics.minTime) : 0.0;
+        stage["maxTime"] = milliseconds(statistics.maxTime);
+
+        stages.append(stage);
+    }
+
+    return stages;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+
+#include <globjects/base/ref_ptr.h>
+
+
+class QJsonArray;
+class QOffscreenSurface;
+class QOpenGLContext;
+class QTextStream;
+
+namespace globjects
+{
+
+class Framebuffer;
+class Renderbuffer;
+class Texture;
+
+}
+
+namespace gloperate
+{
+
+class AbstractPipeline;
+class Painter;
+class PluginManager;
+class ResourceManager;
+
+}
+
+class RunScript;
+
+
+/**
+*  @brief
+*    Renders frames of a painter into an offscreen framebuffer and measures them
+*
+*    The runner creates an OpenGL context on an offscreen surface, so no window
+*    is required. Painters are loaded through the plugin manager. If the painter
+*    executes a pipeline, the pipeline is profiled and per-stage statistics are
+*    part of the report. The pipeline can be compiled to compare the timings of
+*    dynamic and compiled execution.
+*/
+class Runner
+{
+public:
+    Runner();
+    ~Runner();
+
+    bool createContext();
+
+    void addPluginPath(const QString & path);
+    void scanPlugins();
+    QStringList painterNames() const;
+
+    void setCompiled(bool compiled);
+
+    bool loadPainter(const QString & name);
+
+    /**
+    *  @brief
+    *    Render the frames of a script
+    *
+    *  @param[in] script
+    *    Number of frames, viewport size and property changes
+    *  @param[in] stageTimes
+    *    Stream that receives the start and duration (in milliseconds) of each stage
+    *    execution in each frame as CSV, stages that are not processed are omitted (can be null)
+    *
+    *  @return
+    *    Report with frame times (in milliseconds) and stage statistics
+    */
+    QJsonObject run(const RunScript & script, QTextStream * stageTimes = nullptr);
+
+private:
+    void resizeTarget(int width, int height);
+    bool applyChange(const QString & property, const QString & value);
+    gloperate::AbstractPipeline * painterPipeline() const;
+    void writeStageTimes(int frame, QTextStream & stream, long long & lastExecution) const;
+    QJsonArray stageStatistics() const;
+
+private:
+    std::unique_ptr<QOpenGLContext> m_context;
+    std::unique_ptr<QOffscreenSurface> m_surface;
+
+    std::unique_ptr<gloperate::ResourceManager> m_resourceManager;
+    std::unique_ptr<gloperate::PluginManager> m_pluginManager;
+    std::unique_ptr<gloperate::Painter> m_painter;
+    QString m_painterName;
+    bool m_compiled;
+
+    globjects::ref_ptr<globjects::Framebuffer> m_fbo;
+    globjects::ref_ptr<globjects::Texture> m_color;
+    globjects::ref_ptr<globjects::Renderbuffer> m_depth;
+};
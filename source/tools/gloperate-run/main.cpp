@@ -0,0 +1,170 @@
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QFile>
+#include <QGuiApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include "RunScript.h"
+#include "Runner.h"
+
+
+namespace
+{
+
+const auto applicationDescription = R"(
+Renders a painter without a window and reports frame and stage timings as JSON.)";
+
+bool readScript(const QString & path, RunScript & script)
+{
+    QFile file{path};
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "ERROR: Script file could not be opened.";
+        return false;
+    }
+
+    QJsonParseError parseError;
+
+    const auto document = QJsonDocument::fromJson(file.readAll(), &parseError);
+
+    if (parseError.error != QJsonParseError::NoError)
+    {
+        qDebug() << "ERROR: parsing script failed:" << parseError.errorString();
+        return false;
+    }
+
+    QString error;
+
+    if (!RunScript::fromJson(document, script, &error))
+    {
+        qDebug() << "ERROR: invalid script:" << error;
+        return false;
+    }
+
+    return true;
+}
+
+}
+
+int main(int argc, char * argv[])
+{
+    QGuiApplication app(argc, argv);
+    QCoreApplication::setApplicationName("gloperate-run");
+    QCoreApplication::setApplicationVersion("1.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(applicationDescription);
+    parser.addVersionOption();
+    parser.addHelpOption();
+    parser.addPositionalArgument("painter", "name of the painter plugin");
+
+    const QCommandLineOption framesOption("frames", "number of frames to render", "count");
+    const QCommandLineOption sizeOption("size", "size of the viewport", "widthxheight");
+    const QCommandLineOption scriptOption("script", "JSON file with frames, size and property changes", "file");
+    const QCommandLineOption outputOption("output", "file to write the report to (default: standard output)", "file");
+    const QCommandLineOption pluginsOption("plugins", "additional plugin search path", "path");
+    const QCommandLineOption stageTimesOption("stage-times", "file to write the time of each stage in each frame to (CSV)", "file");
+    const QCommandLineOption compiledOption("compiled", "execute the painter's pipeline through a compiled execution plan");
+    const QCommandLineOption listOption("list", "list the available painters");
+
+    parser.addOption(framesOption);
+    parser.addOption(sizeOption);
+    parser.addOption(scriptOption);
+    parser.addOption(outputOption);
+    parser.addOption(pluginsOption);
+    parser.addOption(stageTimesOption);
+    parser.addOption(compiledOption);
+    parser.addOption(listOption);
+
+    parser.process(app);
+
+    // Command line options override the values of the script
+    RunScript script;
+
+    if (parser.isSet(scriptOption) && !readScript(parser.value(scriptOption), script))
+        return 1;
+
+    if (parser.isSet(framesOption))
+        script.setFrames(parser.value(framesOption).toInt());
+
+    if (parser.isSet(sizeOption))
+    {
+        const auto size = parser.value(sizeOption).split('x');
+
+        if (size.size() != 2)
+        {
+            qDebug() << "ERROR: Size has to be given as <width>x<height>.";
+            return 1;
+        }
+
+        script.setSize(size[0].toInt(), size[1].toInt());
+    }
+
+    Runner runner;
+    runner.setCompiled(parser.isSet(compiledOption));
+
+    for (const auto & path : parser.values(pluginsOption))
+        runner.addPluginPath(path);
+
+    runner.scanPlugins();
+
+    if (parser.isSet(listOption))
+    {
+        for (const auto & name : runner.painterNames())
+            QTextStream(stdout) << name << endl;
+
+        return 0;
+    }
+
+    const auto arguments = parser.positionalArguments();
+
+    if (arguments.isEmpty())
+    {
+        qDebug() << "ERROR: No painter specified.";
+        return 1;
+    }
+
+    if (!runner.createContext())
+    {
+        qDebug() << "ERROR: OpenGL context could not be created.";
+        return 1;
+    }
+
+    if (!runner.loadPainter(arguments.first()))
+    {
+        qDebug() << "ERROR: Painter" << arguments.first() << "could not be loaded.";
+        return 1;
+    }
+
+    QFile stageTimesFile{parser.value(stageTimesOption)};
+    QTextStream stageTimes{&stageTimesFile};
+
+    if (parser.isSet(stageTimesOption) && !stageTimesFile.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        qDebug() << "ERROR: Stage times file could not be written.";
+        return 1;
+    }
+
+    const auto report = QJsonDocument(runner.run(script, parser.isSet(stageTimesOption) ? &stageTimes : nullptr)).toJson();
+
+    if (!parser.isSet(outputOption))
+    {
+        QTextStream(stdout) << report;
+        return 0;
+    }
+
+    QFile output{parser.value(outputOption)};
+
+    if (!output.open(QIODevice::WriteOnly))
+    {
+        qDebug() << "ERROR: Report file could not be written.";
+        return 1;
+    }
+
+    output.write(report);
+
+    return 0;
+}